@@ -36,6 +36,18 @@
 #include <Wire.h>
 
 #include <Adafruit_MPU6050.h>
+#include <Adafruit_MPU6050_Math.h>
+
+// unpacks a big-endian accel, temp, gyro data burst or FIFO frame
+static void decodeFrame(const uint8_t *data, mpu6050_raw_frame_t *frame) {
+  frame->accel[0] = data[0] << 8 | data[1];
+  frame->accel[1] = data[2] << 8 | data[3];
+  frame->accel[2] = data[4] << 8 | data[5];
+  frame->temperature = data[6] << 8 | data[7];
+  frame->gyro[0] = data[8] << 8 | data[9];
+  frame->gyro[1] = data[10] << 8 | data[11];
+  frame->gyro[2] = data[12] << 8 | data[13];
+}
 
 /*!
  *    @brief  Instantiates a new MPU6050 class
@@ -69,6 +81,18 @@ Adafruit_MPU6050::~Adafruit_MPU6050(void) {
 
 bool Adafruit_MPU6050::begin(uint8_t i2c_address, TwoWire *wire,
                              int32_t sensor_id) {
+  if (!_connect(i2c_address, wire))
+    return false;
+
+  return _init(sensor_id);
+}
+
+/*!  @brief Creates the I2C interface and checks the chip ID
+ *   @param i2c_address The I2C address to be used
+ *   @param wire The Wire object to be used for I2C connections
+ *   @returns True if an MPU6050 answered at `i2c_address`
+ */
+bool Adafruit_MPU6050::_connect(uint8_t i2c_address, TwoWire *wire) {
   if (i2c_dev) {
     delete i2c_dev; // remove old interface
   }
@@ -91,11 +115,7 @@ bool Adafruit_MPU6050::begin(uint8_t i2c_address, TwoWire *wire,
       Adafruit_BusIO_Register(i2c_dev, MPU6050_WHO_AM_I, 1);
 
   // make sure we're talking to the right chip
-  if (chip_id.read() != MPU6050_DEVICE_ID) {
-    return false;
-  }
-
-  return _init(sensor_id);
+  return chip_id.read() == MPU6050_DEVICE_ID;
 }
 
 /*!  @brief Initilizes the sensor
@@ -103,13 +123,24 @@ bool Adafruit_MPU6050::begin(uint8_t i2c_address, TwoWire *wire,
  *   @returns True if chip identified and initialized
  */
 bool Adafruit_MPU6050::_init(int32_t sensor_id) {
+  reset();
+
+  _configure(sensor_id);
+
+  delay(100);
+
+  return true;
+}
 
+/*!  @brief Applies the default configuration after a reset, without waiting
+ *   for the clock to settle
+ *   @param sensor_id Optional unique ID for the sensor set
+ */
+void Adafruit_MPU6050::_configure(int32_t sensor_id) {
   _sensorid_accel = sensor_id;
   _sensorid_gyro = sensor_id + 1;
   _sensorid_temp = sensor_id + 2;
 
-  reset();
-
   setSampleRateDivisor(0);
 
   setFilterBandwidth(MPU6050_BAND_260_HZ);
@@ -123,8 +154,6 @@ bool Adafruit_MPU6050::_init(int32_t sensor_id) {
 
   power_mgmt_1.write(0x01); // set clock config to PLL with Gyro X reference
 
-  delay(100);
-
   // remove old reference
   if (temp_sensor)
     delete temp_sensor;
@@ -136,9 +165,8 @@ bool Adafruit_MPU6050::_init(int32_t sensor_id) {
   temp_sensor = new Adafruit_MPU6050_Temp(this);
   accel_sensor = new Adafruit_MPU6050_Accelerometer(this);
   gyro_sensor = new Adafruit_MPU6050_Gyro(this);
-
-  return true;
 }
+
 /**************************************************************************/
 /*!
     @brief Resets registers to their initial value and resets the sensors'
@@ -146,23 +174,53 @@ bool Adafruit_MPU6050::_init(int32_t sensor_id) {
 */
 /**************************************************************************/
 void Adafruit_MPU6050::reset(void) {
+  // see register map page 41
+  _startReset();
+  while (_resetPending()) { // check for the post reset value
+    delay(1);
+  }
+  delay(100);
+
+  _resetSignalPaths();
+
+  delay(100);
+}
+
+/*!  @brief Starts a device reset without waiting for it to complete
+ */
+void Adafruit_MPU6050::_startReset(void) {
   Adafruit_BusIO_Register power_mgmt_1 =
       Adafruit_BusIO_Register(i2c_dev, MPU6050_PWR_MGMT_1, 1);
-  Adafruit_BusIO_Register sig_path_reset =
-      Adafruit_BusIO_Register(i2c_dev, MPU6050_SIGNAL_PATH_RESET, 1);
   Adafruit_BusIO_RegisterBits device_reset =
       Adafruit_BusIO_RegisterBits(&power_mgmt_1, 1, 7);
 
-  // see register map page 41
-  device_reset.write(1);             // reset
-  while (device_reset.read() == 1) { // check for the post reset value
-    delay(1);
-  }
-  delay(100);
+  device_reset.write(1);
+}
+
+/*!  @brief Checks whether a reset started with `_startReset` is running
+ *   @returns True until the reset bit reads back as cleared
+ */
+bool Adafruit_MPU6050::_resetPending(void) {
+  Adafruit_BusIO_Register power_mgmt_1 =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_PWR_MGMT_1, 1);
+  Adafruit_BusIO_RegisterBits device_reset =
+      Adafruit_BusIO_RegisterBits(&power_mgmt_1, 1, 7);
+
+  return device_reset.read() == 1;
+}
+
+/*!  @brief Resets the analog and digital signal paths after a device reset
+ */
+void Adafruit_MPU6050::_resetSignalPaths(void) {
+  Adafruit_BusIO_Register sig_path_reset =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_SIGNAL_PATH_RESET, 1);
 
   sig_path_reset.write(0x7);
 
-  delay(100);
+  // ranges are back to their power-on defaults
+  _accel_scale = 16384;
+  _gyro_scale = 131;
+  _fsync_out = MPU6050_FSYNC_OUT_DISABLED;
 }
 
 /**************************************************************************/
@@ -220,6 +278,9 @@ void Adafruit_MPU6050::setAccelerometerRange(mpu6050_accel_range_t new_range) {
   Adafruit_BusIO_RegisterBits accel_range =
       Adafruit_BusIO_RegisterBits(&accel_config, 2, 3);
   accel_range.write(new_range);
+
+  // 16384 LSB/g at +/- 2g, halving for each doubling of the range
+  _accel_scale = 16384 >> new_range;
 }
 /**************************************************************************/
 /*!
@@ -250,8 +311,35 @@ void Adafruit_MPU6050::setGyroRange(mpu6050_gyro_range_t new_range) {
       Adafruit_BusIO_RegisterBits(&gyro_config, 2, 3);
 
   gyro_range.write(new_range);
+
+  if (new_range == MPU6050_RANGE_250_DEG)
+    _gyro_scale = 131;
+  if (new_range == MPU6050_RANGE_500_DEG)
+    _gyro_scale = 65.5;
+  if (new_range == MPU6050_RANGE_1000_DEG)
+    _gyro_scale = 32.8;
+  if (new_range == MPU6050_RANGE_2000_DEG)
+    _gyro_scale = 16.4;
 }
 
+/**************************************************************************/
+/*!
+    @brief Gets the accelerometer sensitivity for the range last set with
+    `setAccelerometerRange`, without a bus transaction
+    @return  The accelerometer scale in LSB per g
+*/
+/**************************************************************************/
+float Adafruit_MPU6050::getAccelerometerScale(void) { return _accel_scale; }
+
+/**************************************************************************/
+/*!
+    @brief Gets the gyroscope sensitivity for the range last set with
+    `setGyroRange`, without a bus transaction
+    @return  The gyroscope scale in LSB per deg/s
+*/
+/**************************************************************************/
+float Adafruit_MPU6050::getGyroScale(void) { return _gyro_scale; }
+
 /**************************************************************************/
 /*!
     @brief Sets clock source.
@@ -311,6 +399,63 @@ void Adafruit_MPU6050::setFsyncSampleOutput(mpu6050_fsync_out_t fsync_output) {
   Adafruit_BusIO_RegisterBits fsync_out =
       Adafruit_BusIO_RegisterBits(&config, 3, 3);
   fsync_out.write(fsync_output);
+
+  _fsync_out = fsync_output;
+  _fsync_last = false;
+}
+
+/**************************************************************************/
+/*!
+*     @brief  Gets the FSYNC pin state latched into a frame
+*     @param  frame
+              A frame read while `setFsyncSampleOutput` was set to something
+              other than `MPU6050_FSYNC_OUT_DISABLED`
+*     @return True if an FSYNC pulse was latched for this sample.
+              Always false while FSYNC sampling is disabled.
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050::getFsyncFlag(const mpu6050_raw_frame_t *frame) {
+  switch (_fsync_out) {
+  case MPU6050_FSYNC_OUT_TEMP:
+    return frame->temperature & 1;
+  case MPU6050_FSYNC_OUT_GYROX:
+  case MPU6050_FSYNC_OUT_GYROY:
+  case MPU6050_FSYNC_OUT_GYROZ:
+    return frame->gyro[_fsync_out - MPU6050_FSYNC_OUT_GYROX] & 1;
+  case MPU6050_FSYNC_OUT_ACCELX:
+  case MPU6050_FSYNC_OUT_ACCELY:
+  case MPU6050_FSYNC_OUT_ACCEL_Z:
+    return frame->accel[_fsync_out - MPU6050_FSYNC_OUT_ACCELX] & 1;
+  default:
+    return false;
+  }
+}
+
+/**************************************************************************/
+/*!
+*     @brief  Finds the first frame where the FSYNC flag becomes set.
+              The flag state is carried over between calls, so consecutive
+              FIFO blocks can be searched one after the other.
+              Devices sharing one sync signal can be aligned by lining up
+              the frames returned for each of them.
+*     @param  frames
+              Frames in the order they were sampled
+*     @param  count
+              The number of frames to search
+*     @return The index of the first frame with a rising flag, or -1 if there
+              is none in `frames`
+*/
+/**************************************************************************/
+int16_t Adafruit_MPU6050::findFsyncEdge(const mpu6050_raw_frame_t *frames,
+                                        uint16_t count) {
+  int16_t edge = -1;
+  for (uint16_t i = 0; i < count; i++) {
+    bool flag = getFsyncFlag(&frames[i]);
+    if (flag && !_fsync_last && edge < 0)
+      edge = i;
+    _fsync_last = flag;
+  }
+  return edge;
 }
 
 /**************************************************************************/
@@ -475,6 +620,204 @@ void Adafruit_MPU6050::setMotionDetectionDecrement(uint8_t dec) {
   motion_decrement.write(dec);
 }
 
+/**************************************************************************/
+/*!
+*     @brief  Sets the free-fall interrupt
+*     @param  active
+              If `true` free-fall interrupt will activate when all axes are
+              below thr for dur
+              If `false` free-fall interrupt will be disabled
+*/
+/**************************************************************************/
+void Adafruit_MPU6050::setFreefallInterrupt(bool active) {
+  Adafruit_BusIO_Register int_enable =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_INT_ENABLE, 1);
+  Adafruit_BusIO_RegisterBits int_freefall =
+      Adafruit_BusIO_RegisterBits(&int_enable, 1, 7);
+  int_freefall.write(active);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Sets the free-fall detection threshold
+ *     @param  thr
+ *             The acceleration every axis must stay below, LSB = 2 mg
+ */
+/**************************************************************************/
+void Adafruit_MPU6050::setFreefallDetectionThreshold(uint8_t thr) {
+  Adafruit_BusIO_Register threshold =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_FF_THR, 1);
+  threshold.write(thr);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Sets the free-fall detection duration
+ *     @param  dur
+ *             The time the threshold must be met for, LSB = 1 ms
+ */
+/**************************************************************************/
+void Adafruit_MPU6050::setFreefallDetectionDuration(uint8_t dur) {
+  Adafruit_BusIO_Register duration =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_FF_DUR, 1);
+  duration.write(dur);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Sets the free-fall detection internal counter decrement
+ *     @param  dec
+ *             How fast the duration counter falls when the threshold isn't
+ *             met: 0 resets it, 1 to 3 decrement by 1, 2 or 4
+ */
+/**************************************************************************/
+void Adafruit_MPU6050::setFreefallDetectionDecrement(uint8_t dec) {
+  Adafruit_BusIO_Register mot_detect_ctrl =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_MOT_DETECT_CTRL, 1);
+  Adafruit_BusIO_RegisterBits freefall_decrement =
+      Adafruit_BusIO_RegisterBits(&mot_detect_ctrl, 2, 2);
+
+  freefall_decrement.write(dec);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Gets free-fall interrupt status
+ *     @return  freefall_interrupt
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::getFreefallInterruptStatus(void) {
+  Adafruit_BusIO_Register status =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_INT_STATUS, 1);
+
+  Adafruit_BusIO_RegisterBits freefall =
+      Adafruit_BusIO_RegisterBits(&status, 1, 7);
+  return (bool)freefall.read();
+}
+
+/**************************************************************************/
+/*!
+*     @brief  Sets the zero-motion interrupt
+*     @param  active
+              If `true` zero-motion interrupt will activate when motion stops
+              for dur, and again when motion resumes
+              If `false` zero-motion interrupt will be disabled
+*/
+/**************************************************************************/
+void Adafruit_MPU6050::setZeroMotionInterrupt(bool active) {
+  Adafruit_BusIO_Register int_enable =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_INT_ENABLE, 1);
+  Adafruit_BusIO_RegisterBits int_zero_motion =
+      Adafruit_BusIO_RegisterBits(&int_enable, 1, 5);
+  int_zero_motion.write(active);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Sets the zero-motion detection threshold
+ *     @param  thr
+ *             The high-pass filtered acceleration every axis must stay
+ *             below, LSB = 2 mg
+ */
+/**************************************************************************/
+void Adafruit_MPU6050::setZeroMotionDetectionThreshold(uint8_t thr) {
+  Adafruit_BusIO_Register threshold =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_ZRMOT_THR, 1);
+  threshold.write(thr);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Sets the zero-motion detection duration
+ *     @param  dur
+ *             The time the threshold must be met for, LSB = 64 ms
+ */
+/**************************************************************************/
+void Adafruit_MPU6050::setZeroMotionDetectionDuration(uint8_t dur) {
+  Adafruit_BusIO_Register duration =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_ZRMOT_DUR, 1);
+  duration.write(dur);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Gets zero-motion interrupt status. The interrupt is raised
+ *             both when motion stops and when it resumes; use
+ *             `getMotionDetectionStatus` to tell which.
+ *     @return  zero_motion_interrupt
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::getZeroMotionInterruptStatus(void) {
+  Adafruit_BusIO_Register status =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_INT_STATUS, 1);
+
+  Adafruit_BusIO_RegisterBits zero_motion =
+      Adafruit_BusIO_RegisterBits(&status, 1, 5);
+  return (bool)zero_motion.read();
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Gets the motion detector's direction and zero-motion state
+ *     @return  `MPU6050_MOT_XNEG` to `MPU6050_MOT_ZPOS` flags for the axes
+ *              and directions that triggered motion detection, and
+ *              `MPU6050_MOT_ZRMOT` while zero-motion is detected
+ */
+/**************************************************************************/
+uint8_t Adafruit_MPU6050::getMotionDetectionStatus(void) {
+  Adafruit_BusIO_Register mot_detect_status =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_MOT_DETECT_STATUS, 1);
+  return mot_detect_status.read();
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Reads every interrupt flag at once. Reading `INT_STATUS`
+ *             clears it, so checking flags one at a time with the
+ *             `get...InterruptStatus` functions can lose events.
+ *             `INT_STATUS` is directly followed by the data registers and,
+ *             after the aux sensor data, `MOT_DETECT_STATUS`, so the sample
+ *             and motion flags come from the same burst.
+ *     @param  status
+ *             Pointer to a `mpu6050_int_status_t` to be filled
+ *     @param  sample
+ *             Optional pointer to a `mpu6050_sample_t` to be filled with
+ *             the data read alongside the flags
+ *     @param  motion
+ *             If `true` the motion detector flags are read too, making the
+ *             burst 40 bytes long. By default `status->motion` is set to 0
+ *             and only the flags, and the sample if requested, are read.
+ *     @return True on successful read
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::readInterruptStatus(mpu6050_int_status_t *status,
+                                           mpu6050_sample_t *sample,
+                                           bool motion) {
+  uint8_t len = 1;
+  if (sample)
+    len = 1 + MPU6050_FRAME_SIZE;
+  if (motion)
+    len = MPU6050_MOT_DETECT_STATUS - MPU6050_INT_STATUS + 1;
+
+  Adafruit_BusIO_Register status_reg =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_INT_STATUS, len);
+
+  uint8_t buffer[MPU6050_MOT_DETECT_STATUS - MPU6050_INT_STATUS + 1];
+  uint32_t timestamp = millis();
+  if (!status_reg.read(buffer, len))
+    return false;
+
+  status->interrupts = buffer[0];
+  status->motion = motion ? buffer[len - 1] : 0;
+
+  if (sample) {
+    sample->timestamp = timestamp;
+    _decode(buffer + 1, &sample->raw);
+    sample->sequence = _sequence++;
+  }
+  return true;
+}
+
 /**************************************************************************/
 /*!
 *     @brief  Connects or disconects the I2C master pins to the main I2C pins
@@ -500,6 +843,159 @@ void Adafruit_MPU6050::setI2CBypass(bool bypass) {
   i2c_master_enable.write(!bypass);
 }
 
+/**************************************************************************/
+/*!
+*     @brief  Enables or disables the MPU6050's own I2C master on the
+              auxiliary pins, for polling external sensors
+*     @param  enable
+              If `true` bypass is turned off and the master runs at 400 kHz.
+              Data ready is delayed until the aux sensors have been read, so
+              every burst holds matching data.
+              If `false` the master is stopped.
+      @returns True or false on successful write
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050::enableI2CMaster(bool enable) {
+  Adafruit_BusIO_Register user_ctrl =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_USER_CTRL, 1);
+  Adafruit_BusIO_RegisterBits i2c_master_enable =
+      Adafruit_BusIO_RegisterBits(&user_ctrl, 1, 5);
+
+  if (!enable)
+    return i2c_master_enable.write(0);
+
+  Adafruit_BusIO_Register int_pin_config =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_INT_PIN_CONFIG, 1);
+  Adafruit_BusIO_RegisterBits i2c_bypass =
+      Adafruit_BusIO_RegisterBits(&int_pin_config, 1, 1);
+  Adafruit_BusIO_Register mst_ctrl =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_I2C_MST_CTRL, 1);
+
+  if (!i2c_bypass.write(0))
+    return false;
+  // WAIT_FOR_ES, I2C_MST_CLK 13 = 400 kHz
+  if (!mst_ctrl.write(0x4D))
+    return false;
+  return i2c_master_enable.write(1);
+}
+
+/**************************************************************************/
+/*!
+*     @brief  Writes one register of an auxiliary sensor through slave 4.
+              The write happens at the next sample, so this waits for up to
+              one sample period.
+*     @param  aux_addr
+              The 7-bit I2C address of the auxiliary sensor
+*     @param  reg
+              The register to write
+*     @param  value
+              The value to write
+      @returns True if the auxiliary sensor acknowledged the write
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050::writeAuxRegister(uint8_t aux_addr, uint8_t reg,
+                                        uint8_t value) {
+  Adafruit_BusIO_Register slv4 =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_I2C_SLV4_ADDR, 4);
+  Adafruit_BusIO_Register mst_status =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_I2C_MST_STATUS, 1);
+
+  // SLV4_ADDR, SLV4_REG, SLV4_DO, SLV4_CTRL with SLV4_EN set
+  uint8_t buffer[4] = {(uint8_t)(aux_addr & 0x7F), reg, value, 0x80};
+  if (!slv4.write(buffer, 4))
+    return false;
+
+  for (uint8_t i = 0; i < 100; i++) {
+    uint8_t status = mst_status.read();
+    if (status & 0x10) // I2C_SLV4_NACK
+      return false;
+    if (status & 0x40) // I2C_SLV4_DONE
+      return true;
+    delay(1);
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+*     @brief  Sets up one of slaves 0-3 to read an auxiliary sensor at every
+              sample. Data from enabled slaves is stored one after the other,
+              in slave order, from `MPU6050_EXT_SENS_DATA_00`.
+*     @param  slave
+              The slave to use, 0 to 3
+*     @param  aux_addr
+              The 7-bit I2C address of the auxiliary sensor
+*     @param  reg
+              The first register to read
+*     @param  len
+              The number of bytes to read, 1 to 15
+      @returns True or false on successful write
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050::setAuxSlaveRead(uint8_t slave, uint8_t aux_addr,
+                                       uint8_t reg, uint8_t len) {
+  if (slave > 3 || len == 0 || len > 15)
+    return false;
+
+  Adafruit_BusIO_Register slv =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_I2C_SLV0_ADDR + 3 * slave, 3);
+
+  // I2C_SLVn_RW set for a read, I2C_SLVn_EN and I2C_SLVn_LEN
+  uint8_t buffer[3] = {(uint8_t)(0x80 | aux_addr), reg, (uint8_t)(0x80 | len)};
+  return slv.write(buffer, 3);
+}
+
+/**************************************************************************/
+/*!
+*     @brief  Stops one of slaves 0-3 from reading its auxiliary sensor
+*     @param  slave
+              The slave to disable, 0 to 3
+      @returns True or false on successful write
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050::disableAuxSlave(uint8_t slave) {
+  if (slave > 3)
+    return false;
+
+  Adafruit_BusIO_Register slv_ctrl = Adafruit_BusIO_Register(
+      i2c_dev, MPU6050_I2C_SLV0_ADDR + 3 * slave + 2, 1);
+  return slv_ctrl.write(0x00);
+}
+
+/**************************************************************************/
+/*!
+*     @brief  Reads one sample and the auxiliary sensor data in a single
+              burst, since `MPU6050_EXT_SENS_DATA_00` directly follows the
+              gyro data registers
+*     @param  sample
+              Pointer to a `mpu6050_sample_t` to be filled
+*     @param  ext_data
+              Buffer for the auxiliary sensor bytes
+*     @param  ext_len
+              The number of auxiliary bytes to read, up to
+              `MPU6050_EXT_SENS_DATA_SIZE`
+      @returns True on successful read
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050::getExtendedSample(mpu6050_sample_t *sample,
+                                         uint8_t *ext_data, uint8_t ext_len) {
+  if (ext_len > MPU6050_EXT_SENS_DATA_SIZE)
+    ext_len = MPU6050_EXT_SENS_DATA_SIZE;
+
+  Adafruit_BusIO_Register data_reg = Adafruit_BusIO_Register(
+      i2c_dev, MPU6050_ACCEL_OUT, MPU6050_FRAME_SIZE + ext_len);
+
+  uint8_t buffer[MPU6050_FRAME_SIZE + MPU6050_EXT_SENS_DATA_SIZE];
+  sample->timestamp = millis();
+  if (!data_reg.read(buffer, MPU6050_FRAME_SIZE + ext_len))
+    return false;
+
+  _decode(buffer, &sample->raw);
+  memcpy(ext_data, buffer + MPU6050_FRAME_SIZE, ext_len);
+  sample->sequence = _sequence++;
+  return true;
+}
+
 /**************************************************************************/
 /*!
 *     @brief  Controls the sleep state of the sensor
@@ -645,63 +1141,852 @@ bool Adafruit_MPU6050::setTemperatureStandby(bool enable) {
   return temp_stdby.write(enable);
 }
 
+/**************************************************************************/
+/*!
+ *     @brief  Gets disable mode for thermometer sensor.
+ *     @return True if the temperature sensor is disabled
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::getTemperatureStandby(void) {
+  Adafruit_BusIO_Register pwr_mgmt =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_PWR_MGMT_1, 1);
+
+  Adafruit_BusIO_RegisterBits temp_stdby =
+      Adafruit_BusIO_RegisterBits(&pwr_mgmt, 1, 3);
+  return temp_stdby.read();
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Enables or disables buffering of measurements in the FIFO
+ *     @param  enable
+ *             If `true` the FIFO is cleared and every accelerometer,
+ *             temperature and gyro sample is queued as a
+ *             `MPU6050_FRAME_SIZE` byte frame at the sample rate.
+ *             Setting `false` stops buffering.
+ *     @return True if setting was successful, otherwise false.
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::enableFifo(bool enable) {
+  Adafruit_BusIO_Register fifo_en =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_FIFO_EN, 1);
+  Adafruit_BusIO_Register user_ctrl =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_USER_CTRL, 1);
+  Adafruit_BusIO_RegisterBits fifo_enable =
+      Adafruit_BusIO_RegisterBits(&user_ctrl, 1, 6);
+
+  if (!enable) {
+    if (!fifo_enable.write(0))
+      return false;
+    return fifo_en.write(0x00);
+  }
+
+  // the FIFO must be stopped while it is reset
+  if (!fifo_enable.write(0))
+    return false;
+  resetFifo();
+  // TEMP, XG, YG, ZG and ACCEL, matching the data register order
+  if (!fifo_en.write(0xF8))
+    return false;
+  return fifo_enable.write(1);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Clears the FIFO. The reset only takes effect while the FIFO
+ *             is stopped, so a running FIFO is stopped for the reset and
+ *             restarted afterwards. The reset bit clears itself once done.
+ */
+/**************************************************************************/
+void Adafruit_MPU6050::resetFifo(void) {
+  Adafruit_BusIO_Register user_ctrl =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_USER_CTRL, 1);
+  Adafruit_BusIO_RegisterBits fifo_enable =
+      Adafruit_BusIO_RegisterBits(&user_ctrl, 1, 6);
+  Adafruit_BusIO_RegisterBits fifo_reset =
+      Adafruit_BusIO_RegisterBits(&user_ctrl, 1, 2);
+
+  bool was_enabled = fifo_enable.read();
+  if (was_enabled)
+    fifo_enable.write(0);
+  fifo_reset.write(1);
+  if (was_enabled)
+    fifo_enable.write(1);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Gets the number of bytes waiting in the FIFO
+ *     @return The FIFO byte count
+ */
+/**************************************************************************/
+uint16_t Adafruit_MPU6050::getFifoCount(void) {
+  Adafruit_BusIO_Register fifo_count =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_FIFO_COUNT_H, 2, MSBFIRST);
+  return fifo_count.read();
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Reads whole frames out of the FIFO. If the FIFO has overflowed
+ *             it is restarted, nothing is read and `getFifoOverflows` goes
+ *             up by one.
+ *     @param  frames
+ *             Array to be filled with the oldest frames in the FIFO
+ *     @param  max_frames
+ *             The number of frames `frames` can hold
+ *     @return The number of frames read
+ */
+/**************************************************************************/
+uint16_t Adafruit_MPU6050::readFifoFrames(mpu6050_raw_frame_t *frames,
+                                          uint16_t max_frames) {
+  uint16_t fifo_count = getFifoCount();
+  if (fifo_count >= MPU6050_FIFO_SIZE) {
+    // overflowed; the oldest frame was partly overwritten so none line up
+    enableFifo(true);
+    _fifo_overflows++;
+    return 0;
+  }
+
+  uint16_t available = fifo_count / MPU6050_FRAME_SIZE;
+  if (available > max_frames)
+    available = max_frames;
+
+  // read as many frames per transaction as the bus buffer allows
+  uint8_t buffer[MPU6050_FRAME_SIZE * 4];
+  uint8_t per_read = i2c_dev->maxBufferSize() / MPU6050_FRAME_SIZE;
+  if (per_read == 0)
+    per_read = 1;
+  if (per_read > 4)
+    per_read = 4;
+
+  Adafruit_BusIO_Register fifo_data =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_FIFO_R_W, 1);
+
+  uint16_t count = 0;
+  while (count < available) {
+    uint8_t chunk = per_read;
+    if (available - count < chunk)
+      chunk = available - count;
+    if (!fifo_data.read(buffer, chunk * MPU6050_FRAME_SIZE))
+      break;
+
+    for (uint8_t i = 0; i < chunk; i++) {
+      _decode(buffer + i * MPU6050_FRAME_SIZE, &frames[count]);
+      count++;
+    }
+  }
+  return count;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Measures the gyro bias while the sensor is held still and
+ *             cancels it with the on-chip user offset registers, so later
+ *             samples, including FIFO frames, need no correction.
+ *             Uses the FIFO, which is reset and left as it was found.
+ *     @param  duration
+ *             The averaging window in milliseconds
+ *     @return The largest remaining bias of the three axes in deg/s,
+ *             measured over a quarter of `duration`, or -1 if no samples
+ *             could be read
+ */
+/**************************************************************************/
+float Adafruit_MPU6050::calibrateGyro(uint16_t duration) {
+  int32_t accel_sum[3], gyro_sum[3];
+  int16_t offsets[3];
+
+  uint16_t count = _averageFifo(duration, accel_sum, gyro_sum);
+  if (count == 0 || !getGyroOffsets(offsets))
+    return -1;
+
+  // offset registers are in +/- 1000 deg/s LSBs whatever the range
+  float offset_per_lsb = 32.8 / _gyro_scale;
+  for (uint8_t i = 0; i < 3; i++) {
+    float bias = (float)gyro_sum[i] / count * offset_per_lsb;
+    offsets[i] -= (int16_t)(bias < 0 ? bias - 0.5 : bias + 0.5);
+  }
+  if (!setGyroOffsets(offsets))
+    return -1;
+
+  count = _averageFifo(duration / 4, accel_sum, gyro_sum);
+  if (count == 0)
+    return -1;
+
+  float residual = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    float bias = fabs((float)gyro_sum[i] / count) / _gyro_scale;
+    if (bias > residual)
+      residual = bias;
+  }
+  return residual;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Reads the gyro user offsets, for saving a calibration
+ *     @param  offsets
+ *             Filled with the X, Y and Z offsets in +/- 1000 deg/s LSBs
+ *     @return True on successful read
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::getGyroOffsets(int16_t offsets[3]) {
+  Adafruit_BusIO_Register offs_usr =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_XG_OFFS_USRH, 6);
+
+  uint8_t buffer[6];
+  if (!offs_usr.read(buffer, 6))
+    return false;
+  for (uint8_t i = 0; i < 3; i++)
+    offsets[i] = buffer[2 * i] << 8 | buffer[2 * i + 1];
+  return true;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Writes the gyro user offsets, for restoring a saved
+ *             calibration
+ *     @param  offsets
+ *             The X, Y and Z offsets from `getGyroOffsets`
+ *     @return True on successful write
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::setGyroOffsets(const int16_t offsets[3]) {
+  Adafruit_BusIO_Register offs_usr =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_XG_OFFS_USRH, 6);
+
+  uint8_t buffer[6];
+  for (uint8_t i = 0; i < 3; i++) {
+    buffer[2 * i] = offsets[i] >> 8;
+    buffer[2 * i + 1] = offsets[i] & 0xFF;
+  }
+  return offs_usr.write(buffer, 6);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Sets the correction applied to accelerometer readings by
+ *             `getEvent` and the accelerometer sensor object
+ *     @param  cal
+ *             The calibration to apply, or NULL for none. It is not copied,
+ *             so it must stay valid while in use.
+ */
+/**************************************************************************/
+void Adafruit_MPU6050::setAccelerometerCalibration(
+    const mpu6050_accel_cal_t *cal) {
+  _accel_cal = cal;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Sets the temperature dependent bias removed from every sample
+ *             and FIFO frame, using the temperature read with it. Set it
+ *             before `calibrateGyro` or `calibrateAccelerometer`, so the
+ *             offsets they trim are only the bias the table leaves.
+ *     @param  table
+ *             The compensation table, or NULL for none. It is not copied,
+ *             so it must stay valid while in use.
+ */
+/**************************************************************************/
+void Adafruit_MPU6050::setTemperatureCompensation(
+    const mpu6050_temp_comp_t *table) {
+  _temp_comp = table;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Measures the accelerometer offset while the sensor is held
+ *             still with one axis vertical, and trims it out with the
+ *             on-chip offset registers. The axis reading closest to +/- 1g
+ *             is taken to be vertical. Uses the FIFO, which is reset and
+ *             left as it was found.
+ *     @param  duration
+ *             The averaging window in milliseconds
+ *     @return The largest remaining offset of the three axes in g,
+ *             measured over a quarter of `duration`, or -1 if no samples
+ *             could be read
+ */
+/**************************************************************************/
+float Adafruit_MPU6050::calibrateAccelerometer(uint16_t duration) {
+  int32_t accel_sum[3], gyro_sum[3];
+  int16_t offsets[3];
+  float mean[3];
+
+  uint16_t count = _averageFifo(duration, accel_sum, gyro_sum);
+  if (count == 0 || !getAccelerometerOffsets(offsets))
+    return -1;
+
+  uint8_t vertical = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    mean[i] = (float)accel_sum[i] / count;
+    if (fabs(mean[i]) > fabs(mean[vertical]))
+      vertical = i;
+  }
+  mean[vertical] -= mean[vertical] < 0 ? -_accel_scale : _accel_scale;
+
+  // offset registers are in +/- 16g LSBs whatever the range, and bit 0 is
+  // reserved, so only even adjustments are made
+  float offset_per_lsb = 2048 / _accel_scale;
+  for (uint8_t i = 0; i < 3; i++) {
+    float bias = mean[i] * offset_per_lsb / 2;
+    offsets[i] -= 2 * (int16_t)(bias < 0 ? bias - 0.5 : bias + 0.5);
+  }
+  if (!setAccelerometerOffsets(offsets))
+    return -1;
+
+  count = _averageFifo(duration / 4, accel_sum, gyro_sum);
+  if (count == 0)
+    return -1;
+
+  float residual = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    float offset = (float)accel_sum[i] / count;
+    if (i == vertical)
+      offset -= offset < 0 ? -_accel_scale : _accel_scale;
+    offset = fabs(offset) / _accel_scale;
+    if (offset > residual)
+      residual = offset;
+  }
+  return residual;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Reads the accelerometer offsets, for saving a calibration
+ *     @param  offsets
+ *             Filled with the X, Y and Z offsets in +/- 16g LSBs. Bit 0 of
+ *             each is reserved and is not part of the offset.
+ *     @return True on successful read
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::getAccelerometerOffsets(int16_t offsets[3]) {
+  Adafruit_BusIO_Register offs =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_XA_OFFS_H, 6);
+
+  uint8_t buffer[6];
+  if (!offs.read(buffer, 6))
+    return false;
+  for (uint8_t i = 0; i < 3; i++)
+    offsets[i] = buffer[2 * i] << 8 | buffer[2 * i + 1];
+  return true;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Writes the accelerometer offsets, for restoring a saved
+ *             calibration. The chip's current bit 0 values, which hold
+ *             factory temperature compensation state, are kept.
+ *     @param  offsets
+ *             The X, Y and Z offsets from `getAccelerometerOffsets`
+ *     @return True on successful write
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::setAccelerometerOffsets(const int16_t offsets[3]) {
+  Adafruit_BusIO_Register offs =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_XA_OFFS_H, 6);
+
+  uint8_t buffer[6];
+  if (!offs.read(buffer, 6))
+    return false;
+  for (uint8_t i = 0; i < 3; i++) {
+    buffer[2 * i] = offsets[i] >> 8;
+    buffer[2 * i + 1] = (offsets[i] & 0xFE) | (buffer[2 * i + 1] & 0x01);
+  }
+  return offs.write(buffer, 6);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Runs the built-in self-test. The response to the self-test
+ *             actuation is measured at +/- 250 deg/s and +/- 8g and compared
+ *             to the factory trim stored in `MPU6050_SELF_TEST_X` to
+ *             `MPU6050_SELF_TEST_A`. Takes about 250 ms with the sensor held
+ *             still. Range, filter and rate settings are restored afterwards
+ *             and the FIFO is reset.
+ *     @param  result
+ *             Optional pointer to a `mpu6050_self_test_t` to be filled with
+ *             the deviation of each axis
+ *     @return True if every axis is within `MPU6050_SELF_TEST_LIMIT` of its
+ *             factory trim
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::selfTest(mpu6050_self_test_t *result) {
+  Adafruit_BusIO_Register trim_reg =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_SELF_TEST_X, 4);
+  // SMPLRT_DIV, CONFIG, GYRO_CONFIG and ACCEL_CONFIG
+  Adafruit_BusIO_Register config_reg =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_SMPLRT_DIV, 4);
+
+  uint8_t trim[4], saved[4];
+  if (!trim_reg.read(trim, 4) || !config_reg.read(saved, 4))
+    return false;
+
+  // 44 Hz filter, 250 deg/s and 8g, then self-test on
+  uint8_t test_off[4] = {0x00, (uint8_t)((saved[1] & 0xF8) | 0x03), 0x00,
+                         0x10};
+  uint8_t test_on[4] = {test_off[0], test_off[1], 0xE0, 0xF0};
+
+  int32_t accel_off[3], gyro_off[3], accel_on[3], gyro_on[3];
+  config_reg.write(test_off, 4);
+  delay(20);
+  uint16_t count_off = _averageFifo(100, accel_off, gyro_off);
+  config_reg.write(test_on, 4);
+  delay(20);
+  uint16_t count_on = _averageFifo(100, accel_on, gyro_on);
+  config_reg.write(saved, 4);
+
+  if (count_off == 0 || count_on == 0)
+    return false;
+
+  mpu6050_self_test_t test;
+  test.passed = true;
+  for (uint8_t i = 0; i < 3; i++) {
+    uint8_t gyro_trim = trim[i] & 0x1F;
+    uint8_t accel_trim =
+        (trim[i] >> 3 & 0x1C) | (trim[3] >> (4 - 2 * i) & 0x03);
+
+    // factory trim responses, from the register map's self-test section
+    float gyro_ft = 0, accel_ft = 0;
+    if (gyro_trim)
+      gyro_ft = 25 * 131 * pow(1.046, gyro_trim - 1) * (i == 1 ? -1 : 1);
+    if (accel_trim)
+      accel_ft = 4096 * 0.34 * pow(0.92 / 0.34, (accel_trim - 1) / 30.0);
+
+    float gyro_str =
+        (float)gyro_on[i] / count_on - (float)gyro_off[i] / count_off;
+    float accel_str =
+        (float)accel_on[i] / count_on - (float)accel_off[i] / count_off;
+
+    // an unprogrammed trim can't be checked
+    test.gyro[i] = gyro_ft ? (gyro_str - gyro_ft) / gyro_ft : 0;
+    test.accel[i] = accel_ft ? (accel_str - accel_ft) / accel_ft : 0;
+
+    if (fabs(test.gyro[i]) > MPU6050_SELF_TEST_LIMIT ||
+        fabs(test.accel[i]) > MPU6050_SELF_TEST_LIMIT)
+      test.passed = false;
+  }
+
+  if (result)
+    *result = test;
+  return test.passed;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Writes to the DMP's memory, in chunks as large as the bus
+ *             buffer allows, never crossing a bank boundary
+ *     @param  address
+ *             The memory address, with the bank in the high byte
+ *     @param  data
+ *             The bytes to write
+ *     @param  len
+ *             The number of bytes to write
+ *     @param  progmem
+ *             If `true` `data` is read with `pgm_read_byte`, for images
+ *             stored in flash with `PROGMEM`
+ *     @param  verify
+ *             If `true` each chunk is read back and compared
+ *     @return True if every chunk was written, and verified if requested
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::writeMemory(uint16_t address, const uint8_t *data,
+                                   uint16_t len, bool progmem, bool verify) {
+  Adafruit_BusIO_Register bank_sel =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_BANK_SEL, 2);
+  Adafruit_BusIO_Register mem_r_w =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_MEM_R_W, 1);
+
+  uint8_t buffer[32], check[32];
+  // one byte of the bus buffer carries the register address
+  uint16_t max_chunk = i2c_dev->maxBufferSize() - 1;
+  if (max_chunk > sizeof(buffer))
+    max_chunk = sizeof(buffer);
+
+  uint16_t done = 0;
+  while (done < len) {
+    uint16_t chunk = len - done;
+    if (chunk > max_chunk)
+      chunk = max_chunk;
+    uint16_t bank_left = MPU6050_DMP_BANK_SIZE - (address & 0xFF);
+    if (chunk > bank_left)
+      chunk = bank_left;
+
+    for (uint16_t i = 0; i < chunk; i++)
+      buffer[i] = progmem ? pgm_read_byte(data + done + i) : data[done + i];
+
+    // BANK_SEL and MEM_START_ADDR
+    uint8_t location[2] = {(uint8_t)(address >> 8), (uint8_t)address};
+    if (!bank_sel.write(location, 2) || !mem_r_w.write(buffer, chunk))
+      return false;
+
+    if (verify) {
+      if (!bank_sel.write(location, 2) || !mem_r_w.read(check, chunk))
+        return false;
+      if (memcmp(buffer, check, chunk) != 0)
+        return false;
+    }
+
+    done += chunk;
+    address += chunk;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Reads from the DMP's memory
+ *     @param  address
+ *             The memory address, with the bank in the high byte
+ *     @param  data
+ *             Buffer for the bytes read
+ *     @param  len
+ *             The number of bytes to read
+ *     @return True on successful read
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::readMemory(uint16_t address, uint8_t *data,
+                                  uint16_t len) {
+  Adafruit_BusIO_Register bank_sel =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_BANK_SEL, 2);
+  Adafruit_BusIO_Register mem_r_w =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_MEM_R_W, 1);
+
+  uint16_t done = 0;
+  while (done < len) {
+    uint16_t chunk = len - done;
+    uint16_t bank_left = MPU6050_DMP_BANK_SIZE - (address & 0xFF);
+    if (chunk > bank_left)
+      chunk = bank_left;
+    if (chunk > 255)
+      chunk = 255;
+
+    uint8_t location[2] = {(uint8_t)(address >> 8), (uint8_t)address};
+    if (!bank_sel.write(location, 2) || !mem_r_w.read(data + done, chunk))
+      return false;
+
+    done += chunk;
+    address += chunk;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Uploads and verifies a DMP firmware image and sets its start
+ *             address. The image is not part of this library; it must be a
+ *             MotionApps 2.0 compatible image stored with `PROGMEM`. Any
+ *             configuration blocks the image needs can be written
+ *             afterwards with `writeMemory`.
+ *     @param  firmware
+ *             The firmware image in flash
+ *     @param  size
+ *             The size of the image in bytes
+ *     @param  start_address
+ *             The program start address for the image
+ *     @return True if the image was written and verified
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::loadDmpFirmware(const uint8_t *firmware, uint16_t size,
+                                       uint16_t start_address) {
+  if (!writeMemory(0, firmware, size, true, true))
+    return false;
+
+  // DMP_CFG_1 and DMP_CFG_2
+  Adafruit_BusIO_Register dmp_cfg =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_DMP_CFG_1, 2, MSBFIRST);
+  return dmp_cfg.write(start_address, 2);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Sets how often the DMP writes a packet to the FIFO. Sets the
+ *             sample rate to the 200 Hz the DMP expects, with the 44 Hz
+ *             filter.
+ *     @param  divisor
+ *             Packets are written at 200 Hz / (1 + `divisor`)
+ *     @return True on successful write
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::setDmpOutputRate(uint8_t divisor) {
+  setFilterBandwidth(MPU6050_BAND_44_HZ);
+  setSampleRateDivisor(4);
+
+  // the MotionApps 2.0 FIFO rate divisor lives at bank 2, address 0x16
+  uint8_t rate[2] = {0x00, divisor};
+  return writeMemory(0x0216, rate, 2);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Starts or stops the DMP. Starting resets the DMP and the FIFO
+ *             and hands the FIFO over to DMP packets, so `readFifoFrames`
+ *             can't be used until it is stopped.
+ *     @param  enable
+ *             If `true` the DMP runs the loaded firmware and raises
+ *             DMP_INT for each packet.
+ *             If `false` the DMP and FIFO are stopped.
+ *     @return True if setting was successful, otherwise false.
+ */
+/**************************************************************************/
+bool Adafruit_MPU6050::enableDmp(bool enable) {
+  Adafruit_BusIO_Register user_ctrl =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_USER_CTRL, 1);
+  Adafruit_BusIO_RegisterBits dmp_enable =
+      Adafruit_BusIO_RegisterBits(&user_ctrl, 1, 7);
+  Adafruit_BusIO_RegisterBits fifo_enable =
+      Adafruit_BusIO_RegisterBits(&user_ctrl, 1, 6);
+  Adafruit_BusIO_RegisterBits dmp_reset =
+      Adafruit_BusIO_RegisterBits(&user_ctrl, 1, 3);
+  Adafruit_BusIO_Register fifo_en =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_FIFO_EN, 1);
+  Adafruit_BusIO_Register int_enable =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_INT_ENABLE, 1);
+  Adafruit_BusIO_RegisterBits int_dmp =
+      Adafruit_BusIO_RegisterBits(&int_enable, 1, 1);
+
+  if (!dmp_enable.write(0) || !fifo_enable.write(0))
+    return false;
+  if (!enable)
+    return int_dmp.write(0);
+
+  // the DMP fills the FIFO itself
+  if (!fifo_en.write(0x00))
+    return false;
+  resetFifo();
+  dmp_reset.write(1);
+
+  if (!int_dmp.write(1) || !fifo_enable.write(1))
+    return false;
+  return dmp_enable.write(1);
+}
+
+/**************************************************************************/
+/*!
+ *     @brief  Reads and decodes whole DMP packets from the FIFO. If the
+ *             FIFO has overflowed the DMP is restarted, nothing is read and
+ *             `getFifoOverflows` goes up by one.
+ *     @param  packets
+ *             Array to be filled with the oldest packets in the FIFO
+ *     @param  max_packets
+ *             The number of packets `packets` can hold
+ *     @return The number of packets read
+ */
+/**************************************************************************/
+uint16_t Adafruit_MPU6050::readDmpPackets(mpu6050_dmp_packet_t *packets,
+                                          uint16_t max_packets) {
+  uint16_t fifo_count = getFifoCount();
+  if (fifo_count >= MPU6050_FIFO_SIZE) {
+    // overflowed, so packets no longer start on a packet boundary
+    enableDmp(true);
+    _fifo_overflows++;
+    return 0;
+  }
+
+  uint16_t available = fifo_count / MPU6050_DMP_PACKET_SIZE;
+  if (available > max_packets)
+    available = max_packets;
+
+  Adafruit_BusIO_Register fifo_data =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_FIFO_R_W, 1);
+
+  uint8_t buffer[MPU6050_DMP_PACKET_SIZE];
+  uint16_t count = 0;
+  for (; count < available; count++) {
+    if (!fifo_data.read(buffer, MPU6050_DMP_PACKET_SIZE))
+      break;
+
+    mpu6050_dmp_packet_t *packet = &packets[count];
+    for (uint8_t i = 0; i < 4; i++) {
+      const uint8_t *q = buffer + 4 * i;
+      packet->quat[i] = (int32_t)((uint32_t)q[0] << 24 | (uint32_t)q[1] << 16 |
+                                  (uint32_t)q[2] << 8 | q[3]);
+    }
+    // gyro and accel are the high halves of 32-bit words after the quaternion
+    for (uint8_t i = 0; i < 3; i++) {
+      packet->gyro[i] = buffer[16 + 4 * i] << 8 | buffer[17 + 4 * i];
+      packet->accel[i] = buffer[28 + 4 * i] << 8 | buffer[29 + 4 * i];
+    }
+  }
+  return count;
+}
+
+/*!  @brief Sums FIFO frames over a time window. The sample rate is set to
+ *   200 Hz with the 44 Hz filter for the window, slow enough for the FIFO
+ *   to be drained at 100 kHz without overflowing, and restored afterwards.
+ *   The FIFO is left enabled or disabled as it was found.
+ *   @param duration The window in milliseconds
+ *   @param accel_sum Filled with the summed accelerometer X, Y and Z, in
+ *   raw units after any temperature compensation
+ *   @param gyro_sum Filled with the summed gyro X, Y and Z, likewise
+ *   @returns The number of frames summed, at most 65535 so the sums can't
+ *   overflow
+ */
+uint16_t Adafruit_MPU6050::_averageFifo(uint16_t duration,
+                                        int32_t accel_sum[3],
+                                        int32_t gyro_sum[3]) {
+  Adafruit_BusIO_Register user_ctrl =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_USER_CTRL, 1);
+  Adafruit_BusIO_RegisterBits fifo_enable =
+      Adafruit_BusIO_RegisterBits(&user_ctrl, 1, 6);
+  bool was_enabled = fifo_enable.read();
+  // SMPLRT_DIV and CONFIG
+  Adafruit_BusIO_Register rate_reg =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_SMPLRT_DIV, 2);
+
+  for (uint8_t i = 0; i < 3; i++) {
+    accel_sum[i] = 0;
+    gyro_sum[i] = 0;
+  }
+
+  uint8_t saved[2];
+  if (!rate_reg.read(saved, 2))
+    return 0;
+  // 1 kHz / (1 + 4), keeping the FSYNC setting in CONFIG
+  uint8_t rate[2] = {4, (uint8_t)((saved[1] & 0xF8) | MPU6050_BAND_44_HZ)};
+  rate_reg.write(rate, 2);
+  delay(10); // let the filter settle at the new setting
+
+  enableFifo(true);
+
+  mpu6050_raw_frame_t frames[8];
+  uint16_t count = 0;
+  uint32_t start = millis();
+  while (millis() - start < duration) {
+    // compensated frames, so with a table set the bias measured is only
+    // what the table leaves, and the offsets don't cancel its part again
+    uint16_t n = readFifoFrames(frames, 8);
+    for (uint16_t f = 0; f < n && count < 0xFFFF; f++, count++) {
+      for (uint8_t i = 0; i < 3; i++) {
+        accel_sum[i] += frames[f].accel[i];
+        gyro_sum[i] += frames[f].gyro[i];
+      }
+    }
+  }
+
+  enableFifo(was_enabled);
+  rate_reg.write(saved, 2);
+  return count;
+}
+
 /******************* Adafruit_Sensor functions *****************/
 /*!
  *     @brief  Updates the measurement data for all sensors simultaneously
  */
 /**************************************************************************/
 void Adafruit_MPU6050::_read(void) {
-  // get raw readings
-  Adafruit_BusIO_Register data_reg =
-      Adafruit_BusIO_Register(i2c_dev, MPU6050_ACCEL_OUT, 14);
-
-  uint8_t buffer[14];
-  data_reg.read(buffer, 14);
+  mpu6050_sample_t sample;
+  if (!getSample(&sample))
+    return; // keep the last good reading
 
-  rawAccX = buffer[0] << 8 | buffer[1];
-  rawAccY = buffer[2] << 8 | buffer[3];
-  rawAccZ = buffer[4] << 8 | buffer[5];
+  rawAccX = sample.raw.accel[0];
+  rawAccY = sample.raw.accel[1];
+  rawAccZ = sample.raw.accel[2];
 
-  rawTemp = buffer[6] << 8 | buffer[7];
+  rawTemp = sample.raw.temperature;
 
-  rawGyroX = buffer[8] << 8 | buffer[9];
-  rawGyroY = buffer[10] << 8 | buffer[11];
-  rawGyroZ = buffer[12] << 8 | buffer[13];
+  rawGyroX = sample.raw.gyro[0];
+  rawGyroY = sample.raw.gyro[1];
+  rawGyroZ = sample.raw.gyro[2];
 
   temperature = (rawTemp / 340.0) + 36.53;
 
-  mpu6050_accel_range_t accel_range = getAccelerometerRange();
+  // setup range dependant scaling
+  accX = ((float)rawAccX) / _accel_scale;
+  accY = ((float)rawAccY) / _accel_scale;
+  accZ = ((float)rawAccZ) / _accel_scale;
+
+  if (_accel_cal) {
+    float acc[3] = {accX - _accel_cal->bias[0], accY - _accel_cal->bias[1],
+                    accZ - _accel_cal->bias[2]};
+    const float(*m)[3] = _accel_cal->matrix;
+    accX = m[0][0] * acc[0] + m[0][1] * acc[1] + m[0][2] * acc[2];
+    accY = m[1][0] * acc[0] + m[1][1] * acc[1] + m[1][2] * acc[2];
+    accZ = m[2][0] * acc[0] + m[2][1] * acc[1] + m[2][2] * acc[2];
+  }
 
-  float accel_scale = 1;
-  if (accel_range == MPU6050_RANGE_16_G)
-    accel_scale = 2048;
-  if (accel_range == MPU6050_RANGE_8_G)
-    accel_scale = 4096;
-  if (accel_range == MPU6050_RANGE_4_G)
-    accel_scale = 8192;
-  if (accel_range == MPU6050_RANGE_2_G)
-    accel_scale = 16384;
+  gyroX = ((float)rawGyroX) / _gyro_scale;
+  gyroY = ((float)rawGyroY) / _gyro_scale;
+  gyroZ = ((float)rawGyroZ) / _gyro_scale;
+}
 
-  // setup range dependant scaling
-  accX = ((float)rawAccX) / accel_scale;
-  accY = ((float)rawAccY) / accel_scale;
-  accZ = ((float)rawAccZ) / accel_scale;
+/**************************************************************************/
+/*!
+    @brief  Reads one raw sample with a single data burst
+    @param  sample
+            Pointer to a `mpu6050_sample_t` to be filled. Unlike `getEvent`,
+            no unit conversion or event formatting is done.
+    @return True on successful read
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050::getSample(mpu6050_sample_t *sample) {
+  Adafruit_BusIO_Register data_reg =
+      Adafruit_BusIO_Register(i2c_dev, MPU6050_ACCEL_OUT, 14);
 
-  mpu6050_gyro_range_t gyro_range = getGyroRange();
+  uint8_t buffer[14];
+  sample->timestamp = millis();
+  if (!data_reg.read(buffer, 14))
+    return false;
 
-  float gyro_scale = 1;
-  if (gyro_range == MPU6050_RANGE_250_DEG)
-    gyro_scale = 131;
-  if (gyro_range == MPU6050_RANGE_500_DEG)
-    gyro_scale = 65.5;
-  if (gyro_range == MPU6050_RANGE_1000_DEG)
-    gyro_scale = 32.8;
-  if (gyro_range == MPU6050_RANGE_2000_DEG)
-    gyro_scale = 16.4;
+  _decode(buffer, &sample->raw);
+  sample->sequence = _sequence++;
+  return true;
+}
 
-  gyroX = ((float)rawGyroX) / gyro_scale;
-  gyroY = ((float)rawGyroY) / gyro_scale;
-  gyroZ = ((float)rawGyroZ) / gyro_scale;
+/*!  @brief Unpacks a data burst or FIFO frame and applies temperature
+ *   compensation if a table is set. Every frame the driver returns is
+ *   decoded here.
+ *   @param data The 14 big-endian data bytes
+ *   @param frame The frame to fill
+ */
+void Adafruit_MPU6050::_decode(const uint8_t *data,
+                               mpu6050_raw_frame_t *frame) {
+  decodeFrame(data, frame);
+  if (_temp_comp)
+    _compensate(frame);
+}
+
+/*!  @brief Subtracts the temperature dependent bias from a frame. The LSB
+ *   of an axis carrying the FSYNC flag is kept, so `getFsyncFlag` still
+ *   works on compensated frames.
+ *   @param frame The frame to correct, using its own temperature reading
+ */
+void Adafruit_MPU6050::_compensate(mpu6050_raw_frame_t *frame) {
+  const mpu6050_temp_comp_t *table = _temp_comp;
+  bool fsync = getFsyncFlag(frame);
+  uint8_t shift = table->temp_shift;
+
+  int32_t offset = (int32_t)frame->temperature - table->temp_min;
+  if (offset < 0)
+    offset = 0;
+  uint16_t index = offset >> shift;
+  int32_t frac = offset - ((int32_t)index << shift);
+  if (index >= MPU6050_TEMP_COMP_POINTS - 1) {
+    index = MPU6050_TEMP_COMP_POINTS - 2;
+    frac = (int32_t)1 << shift;
+  }
+
+  const int16_t *accel0 = table->accel[index];
+  const int16_t *accel1 = table->accel[index + 1];
+  const int16_t *gyro0 = table->gyro[index];
+  const int16_t *gyro1 = table->gyro[index + 1];
+  for (uint8_t i = 0; i < 3; i++) {
+    int32_t accel_bias =
+        accel0[i] + (((int32_t)(accel1[i] - accel0[i]) * frac) >> shift);
+    int32_t gyro_bias =
+        gyro0[i] + (((int32_t)(gyro1[i] - gyro0[i]) * frac) >> shift);
+    frame->accel[i] = clamp16(frame->accel[i] - accel_bias);
+    frame->gyro[i] = clamp16(frame->gyro[i] - gyro_bias);
+  }
+
+  int16_t *tagged = NULL;
+  if (_fsync_out >= MPU6050_FSYNC_OUT_GYROX &&
+      _fsync_out <= MPU6050_FSYNC_OUT_GYROZ)
+    tagged = &frame->gyro[_fsync_out - MPU6050_FSYNC_OUT_GYROX];
+  else if (_fsync_out >= MPU6050_FSYNC_OUT_ACCELX &&
+           _fsync_out <= MPU6050_FSYNC_OUT_ACCEL_Z)
+    tagged = &frame->accel[_fsync_out - MPU6050_FSYNC_OUT_ACCELX];
+  if (tagged)
+    *tagged = (*tagged & ~1) | fsync;
 }
 
 /**************************************************************************/
@@ -893,3 +2178,84 @@ bool Adafruit_MPU6050_Temp::getEvent(sensors_event_t *event) {
 
   return true;
 }
+
+/**************************************************************************/
+/*!
+    @brief  Creates a block reader over two caller-owned blocks
+    @param  mpu
+            The MPU6050 to read from. Its FIFO must be enabled with
+            `enableFifo`.
+    @param  block_a
+            First block, at least `block_frames` frames long
+    @param  block_b
+            Second block, at least `block_frames` frames long
+    @param  block_frames
+            The number of frames in each block
+*/
+/**************************************************************************/
+Adafruit_MPU6050_BlockReader::Adafruit_MPU6050_BlockReader(
+    Adafruit_MPU6050 *mpu, mpu6050_raw_frame_t *block_a,
+    mpu6050_raw_frame_t *block_b, uint16_t block_frames) {
+  _mpu = mpu;
+  _fill = block_a;
+  _spare = block_b;
+  _block_frames = block_frames;
+  _overflows = mpu->getFifoOverflows();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Drains the FIFO into the fill block and hands it over when full.
+            If the application still holds the previous block, the new frames
+            are left in the FIFO until `releaseBlock` is called. A FIFO
+            overflow discards the partly filled block, so a block never
+            spans a gap; see `followsGap`.
+    @returns True if a full block is available from `getBlock`
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_BlockReader::update(void) {
+  if (_fill_count < _block_frames) {
+    _fill_count += _mpu->readFifoFrames(_fill + _fill_count,
+                                        _block_frames - _fill_count);
+  }
+
+  uint16_t overflows = _mpu->getFifoOverflows();
+  if (overflows != _overflows) {
+    _overflows = overflows;
+    _fill_count = 0;
+    _gap = true;
+  }
+
+  if (_fill_count == _block_frames && _ready == NULL) {
+    _ready_gap = _gap;
+    _gap = false;
+    _ready = _fill;
+    _fill = _spare;
+    _spare = NULL;
+    _fill_count = 0;
+  }
+  return _ready != NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the most recently completed block
+    @returns Pointer to `blockFrames()` frames, or NULL if no block is ready.
+             The block stays valid until `releaseBlock` is called.
+*/
+/**************************************************************************/
+const mpu6050_raw_frame_t *Adafruit_MPU6050_BlockReader::getBlock(void) {
+  return _ready;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Returns the ready block so it can be filled again
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_BlockReader::releaseBlock(void) {
+  if (_ready == NULL)
+    return;
+  _spare = _ready;
+  _ready = NULL;
+}
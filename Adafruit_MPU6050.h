@@ -26,22 +26,41 @@
 #define MPU6050_I2CADDR_DEFAULT 0x68 ///< MPU6050 default i2c address w/ AD0 high
 #define MPU6050_DEVICE_ID 0x68 ///< The correct MPU6050_WHO_AM_I value
 
+#define MPU6050_XA_OFFS_H 0x06 ///< Accel X factory/user offset, Y and Z follow
 #define MPU6050_SELF_TEST_X 0x0D ///< Self test factory calibrated values register
 #define MPU6050_SELF_TEST_Y 0x0E ///< Self test factory calibrated values register
 #define MPU6050_SELF_TEST_Z 0x0F ///< Self test factory calibrated values register
 #define MPU6050_SELF_TEST_A 0x10 ///< Self test factory calibrated values register
+#define MPU6050_XG_OFFS_USRH 0x13 ///< Gyro X user offset, Y and Z follow
 #define MPU6050_SMPLRT_DIV 0x19  ///< sample rate divisor register
 #define MPU6050_CONFIG 0x1A      ///< General configuration register
 #define MPU6050_GYRO_CONFIG 0x1B ///< Gyro specfic configuration register
 #define MPU6050_ACCEL_CONFIG 0x1C ///< Accelerometer specific configration register
+#define MPU6050_FF_THR 0x1D ///< Free-fall detection threshold, LSB = 2 mg
+#define MPU6050_FF_DUR 0x1E ///< Free-fall duration counter threshold, LSB = 1 ms
+#define MPU6050_ZRMOT_THR 0x21 ///< Zero-motion detection threshold
+#define MPU6050_ZRMOT_DUR 0x22 ///< Zero-motion duration counter, LSB = 64 ms
+#define MPU6050_FIFO_EN 0x23 ///< Selects which measurements are loaded into the FIFO
+#define MPU6050_I2C_MST_CTRL 0x24 ///< Auxiliary I2C master configuration register
+#define MPU6050_I2C_SLV0_ADDR 0x25 ///< Aux slave 0 address, slave n is at +3n
+#define MPU6050_I2C_SLV4_ADDR 0x31 ///< Aux slave 4 address register
+#define MPU6050_I2C_MST_STATUS 0x36 ///< Auxiliary I2C master status register
 #define MPU6050_INT_PIN_CONFIG 0x37 ///< Interrupt pin configuration register
 #define MPU6050_INT_ENABLE 0x38     ///< Interrupt enable configuration register
 #define MPU6050_INT_STATUS 0x3A     ///< Interrupt status register
+#define MPU6050_EXT_SENS_DATA_00 0x49 ///< First byte read from aux sensors
 #define MPU6050_WHO_AM_I 0x75       ///< Divice ID register
+#define MPU6050_MOT_DETECT_STATUS 0x61 ///< Motion direction and zero-motion
 #define MPU6050_SIGNAL_PATH_RESET 0x68 ///< Signal path reset register
 #define MPU6050_USER_CTRL 0x6A         ///< FIFO and I2C Master control register
 #define MPU6050_PWR_MGMT_1 0x6B        ///< Primary power/sleep control register
 #define MPU6050_PWR_MGMT_2 0x6C ///< Secondary power/sleep control register
+#define MPU6050_BANK_SEL 0x6D       ///< DMP memory bank select register
+#define MPU6050_MEM_START_ADDR 0x6E ///< DMP memory address within the bank
+#define MPU6050_MEM_R_W 0x6F        ///< DMP memory read/write register
+#define MPU6050_DMP_CFG_1 0x70 ///< DMP program start address, high byte
+#define MPU6050_FIFO_COUNT_H 0x72 ///< FIFO byte count high byte register
+#define MPU6050_FIFO_R_W 0x74     ///< FIFO data read/write register
 #define MPU6050_TEMP_H 0x41     ///< Temperature data high byte register
 #define MPU6050_TEMP_L 0x42     ///< Temperature data low byte register
 #define MPU6050_ACCEL_OUT 0x3B  ///< base address for sensor data reads
@@ -50,6 +69,28 @@
 #define MPU6050_MOT_DETECT_CTRL 0x69 ///< Change turn on delay of accel, rate at which \
 free fall and motion counters decrement; \
 [5:4] ACCEL_ON_DELAY [3:2] FF_count [1:0] MOT_COUNT
+#define MPU6050_INT_FREEFALL 0x80 ///< Free-fall interrupt flag
+#define MPU6050_INT_MOTION 0x40   ///< Motion interrupt flag
+#define MPU6050_INT_ZERO_MOTION 0x20 ///< Zero-motion interrupt flag
+#define MPU6050_INT_FIFO_OVERFLOW 0x10 ///< FIFO overflow interrupt flag
+#define MPU6050_INT_I2C_MASTER 0x08 ///< Aux I2C master interrupt flag
+#define MPU6050_INT_DMP 0x02        ///< DMP interrupt flag
+#define MPU6050_INT_DATA_READY 0x01 ///< Data ready interrupt flag
+#define MPU6050_MOT_XNEG 0x80 ///< Motion detected on the negative X axis
+#define MPU6050_MOT_XPOS 0x40 ///< Motion detected on the positive X axis
+#define MPU6050_MOT_YNEG 0x20 ///< Motion detected on the negative Y axis
+#define MPU6050_MOT_YPOS 0x10 ///< Motion detected on the positive Y axis
+#define MPU6050_MOT_ZNEG 0x08 ///< Motion detected on the negative Z axis
+#define MPU6050_MOT_ZPOS 0x04 ///< Motion detected on the positive Z axis
+#define MPU6050_MOT_ZRMOT 0x01 ///< Set while zero-motion is detected
+#define MPU6050_FIFO_SIZE 1024 ///< Size of the FIFO in bytes
+#define MPU6050_FRAME_SIZE 14 ///< Bytes in one accel + temp + gyro data frame
+#define MPU6050_EXT_SENS_DATA_SIZE 24 ///< Bytes of aux sensor data registers
+#define MPU6050_TEMP_COMP_POINTS 8 ///< Points in a temperature compensation table
+#define MPU6050_SELF_TEST_LIMIT 0.14 ///< Largest passing deviation from trim
+#define MPU6050_DMP_BANK_SIZE 256 ///< Bytes in each DMP memory bank
+#define MPU6050_DMP_START_ADDRESS 0x0400 ///< MotionApps 2.0 program start
+#define MPU6050_DMP_PACKET_SIZE 42 ///< Bytes in a MotionApps 2.0 FIFO packet
 
 /**
  * @brief FSYNC output values
@@ -148,6 +189,88 @@ typedef enum {
   MPU6050_CYCLE_40_HZ,   ///< 40 Hz
 } mpu6050_cycle_rate_t;
 
+/**
+ * @brief One raw accelerometer, temperature and gyro measurement
+ *
+ * Fields are in the same order as the data registers starting at
+ * `MPU6050_ACCEL_OUT`, which is also the order frames are written to the FIFO.
+ */
+typedef struct {
+  int16_t accel[3];    ///< Raw accelerometer X, Y and Z
+  int16_t temperature; ///< Raw temperature
+  int16_t gyro[3];     ///< Raw gyro X, Y and Z
+} mpu6050_raw_frame_t;
+
+/**
+ * @brief Compact timestamped sample returned by `getSample`
+ *
+ * Holds the raw measurement without unit conversion. Use
+ * `getAccelerometerScale` and `getGyroScale` to convert to g and deg/s, and
+ * `temperature / 340.0 + 36.53` for degrees C.
+ */
+typedef struct {
+  mpu6050_raw_frame_t raw; ///< Raw accelerometer, temperature and gyro data
+  uint16_t sequence;       ///< Increments by one for every sample read
+  uint32_t timestamp;      ///< `millis()` when the sample was read
+} mpu6050_sample_t;
+
+/**
+ * @brief Accelerometer bias, scale and cross-axis correction
+ *
+ * Maps a reading in g to a corrected reading in g as
+ * `corrected = matrix * (reading - bias)`. Plain data, so it can be stored
+ * and loaded as a blob. Produced by `Adafruit_MPU6050_AccelCalibrator`.
+ */
+typedef struct {
+  float bias[3];      ///< Offset of each axis in g
+  float matrix[3][3]; ///< Scale and misalignment correction, row major
+} mpu6050_accel_cal_t;
+
+/**
+ * @brief Temperature dependent bias of the accelerometer and gyro
+ *
+ * Biases are in raw LSBs for the ranges in use when the table was fitted,
+ * at points `2^temp_shift` raw temperature LSBs apart starting at
+ * `temp_min`. Biases between points are interpolated linearly, and
+ * temperatures outside the table use the nearest end point.
+ * Produced by `Adafruit_MPU6050_TempCompFitter`.
+ */
+typedef struct {
+  int16_t temp_min;  ///< Raw temperature of the first point
+  uint8_t temp_shift; ///< Log2 of the raw temperature between points
+  int16_t accel[MPU6050_TEMP_COMP_POINTS][3]; ///< Accel X, Y, Z bias
+  int16_t gyro[MPU6050_TEMP_COMP_POINTS][3];  ///< Gyro X, Y, Z bias
+} mpu6050_temp_comp_t;
+
+/**
+ * @brief Results of `selfTest`
+ *
+ * Each value is the self-test response's deviation from the factory trim
+ * as a fraction, so 0.05 is 5% above the expected response.
+ */
+typedef struct {
+  float accel[3]; ///< Accelerometer X, Y and Z deviation
+  float gyro[3];  ///< Gyro X, Y and Z deviation
+  bool passed;    ///< True if every deviation is within the limit
+} mpu6050_self_test_t;
+
+/**
+ * @brief One FIFO packet written by MotionApps 2.0 DMP firmware
+ */
+typedef struct {
+  int32_t quat[4];  ///< Quaternion W, X, Y and Z with 30 fractional bits
+  int16_t accel[3]; ///< Raw accelerometer X, Y and Z
+  int16_t gyro[3];  ///< Raw gyro X, Y and Z
+} mpu6050_dmp_packet_t;
+
+/**
+ * @brief Interrupt flags captured by `readInterruptStatus`
+ */
+typedef struct {
+  uint8_t interrupts; ///< `MPU6050_INT_FREEFALL` to `MPU6050_INT_DATA_READY`
+  uint8_t motion;     ///< `MPU6050_MOT_XNEG` to `MPU6050_MOT_ZRMOT`
+} mpu6050_int_status_t;
+
 class Adafruit_MPU6050;
 
 /** Adafruit Unified Sensor interface for temperature component of MPU6050 */
@@ -211,6 +334,10 @@ public:
   bool getEvent(sensors_event_t *accel, sensors_event_t *gyro,
                 sensors_event_t *temp);
 
+  bool getSample(mpu6050_sample_t *sample);
+  float getAccelerometerScale(void);
+  float getGyroScale(void);
+
   mpu6050_accel_range_t getAccelerometerRange(void);
   void setAccelerometerRange(mpu6050_accel_range_t);
 
@@ -230,9 +357,34 @@ public:
   void setMotionDetectionDecrement(uint8_t dec);
   bool getMotionInterruptStatus(void);
 
+  void setFreefallInterrupt(bool active);
+  void setFreefallDetectionThreshold(uint8_t thr);
+  void setFreefallDetectionDuration(uint8_t dur);
+  void setFreefallDetectionDecrement(uint8_t dec);
+  bool getFreefallInterruptStatus(void);
+
+  void setZeroMotionInterrupt(bool active);
+  void setZeroMotionDetectionThreshold(uint8_t thr);
+  void setZeroMotionDetectionDuration(uint8_t dur);
+  bool getZeroMotionInterruptStatus(void);
+  uint8_t getMotionDetectionStatus(void);
+  bool readInterruptStatus(mpu6050_int_status_t *status,
+                           mpu6050_sample_t *sample = NULL,
+                           bool motion = false);
+
   mpu6050_fsync_out_t getFsyncSampleOutput(void);
+  bool getFsyncFlag(const mpu6050_raw_frame_t *frame);
+  int16_t findFsyncEdge(const mpu6050_raw_frame_t *frames, uint16_t count);
   void setI2CBypass(bool bypass);
 
+  bool enableI2CMaster(bool enable);
+  bool writeAuxRegister(uint8_t aux_addr, uint8_t reg, uint8_t value);
+  bool setAuxSlaveRead(uint8_t slave, uint8_t aux_addr, uint8_t reg,
+                       uint8_t len);
+  bool disableAuxSlave(uint8_t slave);
+  bool getExtendedSample(mpu6050_sample_t *sample, uint8_t *ext_data,
+                         uint8_t ext_len);
+
   void setClock(mpu6050_clock_select_t);
   mpu6050_clock_select_t getClock(void);
 
@@ -252,6 +404,37 @@ public:
   bool setAccelerometerStandby(bool xAxisStandby, bool yAxisStandby,
                                bool zAxisStandby);
   bool setTemperatureStandby(bool enable);
+  bool getTemperatureStandby(void);
+
+  bool enableFifo(bool enable);
+  void resetFifo(void);
+  uint16_t getFifoCount(void);
+  uint16_t readFifoFrames(mpu6050_raw_frame_t *frames, uint16_t max_frames);
+  /** @brief Gets how many times `readFifoFrames` or `readDmpPackets` found
+      the FIFO overflowed and restarted it. Frames or packets read before
+      and after a change in this count are not contiguous.
+      @returns The overflow count, wrapping at 65535 */
+  uint16_t getFifoOverflows(void) { return _fifo_overflows; }
+
+  float calibrateGyro(uint16_t duration = 1000);
+  bool getGyroOffsets(int16_t offsets[3]);
+  bool setGyroOffsets(const int16_t offsets[3]);
+  void setAccelerometerCalibration(const mpu6050_accel_cal_t *cal);
+  void setTemperatureCompensation(const mpu6050_temp_comp_t *table);
+  float calibrateAccelerometer(uint16_t duration = 1000);
+  bool getAccelerometerOffsets(int16_t offsets[3]);
+  bool setAccelerometerOffsets(const int16_t offsets[3]);
+
+  bool selfTest(mpu6050_self_test_t *result = NULL);
+
+  bool writeMemory(uint16_t address, const uint8_t *data, uint16_t len,
+                   bool progmem = false, bool verify = true);
+  bool readMemory(uint16_t address, uint8_t *data, uint16_t len);
+  bool loadDmpFirmware(const uint8_t *firmware, uint16_t size,
+                       uint16_t start_address = MPU6050_DMP_START_ADDRESS);
+  bool setDmpOutputRate(uint8_t divisor);
+  bool enableDmp(bool enable);
+  uint16_t readDmpPackets(mpu6050_dmp_packet_t *packets, uint16_t max_packets);
 
   void reset(void);
 
@@ -294,12 +477,72 @@ private:
                                                ///< data object
   friend class Adafruit_MPU6050_Gyro; ///< Gives access to private members to
                                       ///< Gyro data object
+  friend class Adafruit_MPU6050_Array; ///< Gives access to the staged
+                                       ///< bring-up used for multiple devices
+
+  bool _connect(uint8_t i2c_address, TwoWire *wire);
+  void _configure(int32_t sensor_id);
+  void _startReset(void);
+  bool _resetPending(void);
+  void _resetSignalPaths(void);
+  void _decode(const uint8_t *data, mpu6050_raw_frame_t *frame);
+  void _compensate(mpu6050_raw_frame_t *frame);
+  uint16_t _averageFifo(uint16_t duration, int32_t accel_sum[3],
+                        int32_t gyro_sum[3]);
 
   int16_t rawAccX, rawAccY, rawAccZ, rawTemp, rawGyroX, rawGyroY, rawGyroZ;
 
+  float _accel_scale = 16384; // LSB per g for the last range set
+  float _gyro_scale = 131;    // LSB per deg/s for the last range set
+  uint16_t _sequence = 0;
+  uint16_t _fifo_overflows = 0;
+  const mpu6050_accel_cal_t *_accel_cal = NULL;
+  const mpu6050_temp_comp_t *_temp_comp = NULL;
+  mpu6050_fsync_out_t _fsync_out = MPU6050_FSYNC_OUT_DISABLED;
+  bool _fsync_last = false; // flag state of the last frame searched
+
   void fillTempEvent(sensors_event_t *temp, uint32_t timestamp);
   void fillAccelEvent(sensors_event_t *accel, uint32_t timestamp);
   void fillGyroEvent(sensors_event_t *gyro, uint32_t timestamp);
 };
 
+/*!
+ *    @brief  Double-buffered block reader for the MPU6050 FIFO
+ *
+ *    Frames are drained from the FIFO into one block while the application
+ *    works on the other. When the fill block is full and the previous block
+ *    has been released the two are swapped by pointer, so no frame is copied
+ *    after it leaves the I2C buffer.
+ */
+class Adafruit_MPU6050_BlockReader {
+public:
+  Adafruit_MPU6050_BlockReader(Adafruit_MPU6050 *mpu,
+                               mpu6050_raw_frame_t *block_a,
+                               mpu6050_raw_frame_t *block_b,
+                               uint16_t block_frames);
+
+  bool update(void);
+  const mpu6050_raw_frame_t *getBlock(void);
+  void releaseBlock(void);
+
+  /** @brief Gets the number of frames in each block
+      @returns The block size in frames */
+  uint16_t blockFrames(void) { return _block_frames; }
+  /** @brief Checks whether frames were lost to a FIFO overflow between the
+      previous block and the one from `getBlock`. The ready block itself is
+      always contiguous.
+      @returns True if the ready block does not follow on from the last */
+  bool followsGap(void) { return _ready_gap; }
+
+private:
+  Adafruit_MPU6050 *_mpu = NULL;
+  mpu6050_raw_frame_t *_fill = NULL;  // block being filled from the FIFO
+  mpu6050_raw_frame_t *_spare = NULL; // released block, next to be filled
+  mpu6050_raw_frame_t *_ready = NULL; // full block owned by the application
+  uint16_t _block_frames = 0;
+  uint16_t _fill_count = 0;
+  uint16_t _overflows = 0; // FIFO overflow count when last checked
+  bool _gap = false, _ready_gap = false;
+};
+
 #endif
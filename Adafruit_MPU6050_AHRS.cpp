@@ -0,0 +1,330 @@
+/*!
+ *  @file Adafruit_MPU6050_AHRS.cpp
+ *
+ *  Quaternion orientation filter for the MPU6050
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_AHRS.h>
+#include <Adafruit_MPU6050_Math.h>
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the filter and resets the orientation to level
+    @param  sample_rate
+            The rate frames are passed to `update`, in Hz
+    @param  gyro_scale
+            The gyro sensitivity in LSB per deg/s, from `getGyroScale`
+    @param  kp
+            Proportional gain of the gravity correction. Higher values follow
+            the accelerometer more closely.
+    @param  ki
+            Integral gain, which slowly learns any remaining gyro bias.
+            0 disables it.
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS::begin(float sample_rate, float gyro_scale,
+                                  float kp, float ki) {
+  _dt = 1 / sample_rate;
+  _half_dt = _dt / 2;
+  _gyro_k = DEG_TO_RAD / gyro_scale;
+  _kp = kp;
+  _ki = ki;
+
+  _q[0] = 1;
+  _q[1] = _q[2] = _q[3] = 0;
+  _integral[0] = _integral[1] = _integral[2] = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Updates the orientation with one frame
+    @param  frame
+            A raw frame from `getSample` or the FIFO
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS::update(const mpu6050_raw_frame_t *frame) {
+  float gx = frame->gyro[0] * _gyro_k;
+  float gy = frame->gyro[1] * _gyro_k;
+  float gz = frame->gyro[2] * _gyro_k;
+  float ax = frame->accel[0], ay = frame->accel[1], az = frame->accel[2];
+  float *q = _q;
+
+  if (ax != 0 || ay != 0 || az != 0) {
+    float recip_norm = invSqrt(ax * ax + ay * ay + az * az);
+    ax *= recip_norm;
+    ay *= recip_norm;
+    az *= recip_norm;
+
+    // gravity direction predicted by the current orientation
+    float vx = 2 * (q[1] * q[3] - q[0] * q[2]);
+    float vy = 2 * (q[0] * q[1] + q[2] * q[3]);
+    float vz = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+
+    float ex = ay * vz - az * vy;
+    float ey = az * vx - ax * vz;
+    float ez = ax * vy - ay * vx;
+
+    if (_ki > 0) {
+      _integral[0] += _ki * ex * _dt;
+      _integral[1] += _ki * ey * _dt;
+      _integral[2] += _ki * ez * _dt;
+      gx += _integral[0];
+      gy += _integral[1];
+      gz += _integral[2];
+    }
+
+    gx += _kp * ex;
+    gy += _kp * ey;
+    gz += _kp * ez;
+  }
+
+  gx *= _half_dt;
+  gy *= _half_dt;
+  gz *= _half_dt;
+
+  float qa = q[0], qb = q[1], qc = q[2];
+  q[0] += -qb * gx - qc * gy - q[3] * gz;
+  q[1] += qa * gx + qc * gz - q[3] * gy;
+  q[2] += qa * gy - qb * gz + q[3] * gx;
+  q[3] += qa * gz + qb * gy - qc * gx;
+
+  float recip_norm =
+      invSqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+  for (uint8_t i = 0; i < 4; i++)
+    q[i] *= recip_norm;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Updates the orientation with a block of consecutive frames
+    @param  frames
+            Frames in the order they were sampled, such as a FIFO block
+    @param  count
+            The number of frames
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS::update(const mpu6050_raw_frame_t *frames,
+                                   uint16_t count) {
+  for (uint16_t i = 0; i < count; i++)
+    update(&frames[i]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the orientation quaternion
+    @param  q
+            Filled with the W, X, Y and Z components
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS::getQuaternion(float q[4]) {
+  for (uint8_t i = 0; i < 4; i++)
+    q[i] = _q[i];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the orientation as Euler angles
+    @param  roll
+            Set to the rotation about X in degrees
+    @param  pitch
+            Set to the rotation about Y in degrees
+    @param  yaw
+            Set to the rotation about Z in degrees
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS::getEuler(float *roll, float *pitch, float *yaw) {
+  quaternionToEuler(_q, roll, pitch, yaw);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Approximates 1 / sqrt(x) with the bit-level estimate and two
+            Newton steps, accurate to about 0.0005%
+    @param  x
+            A positive value
+    @return The inverse square root of `x`
+*/
+/**************************************************************************/
+float Adafruit_MPU6050_AHRS::invSqrt(float x) {
+  float half_x = 0.5f * x;
+  uint32_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  bits = 0x5F375A86 - (bits >> 1);
+  float y;
+  memcpy(&y, &bits, sizeof(y));
+  y *= 1.5f - half_x * y * y;
+  return y * (1.5f - half_x * y * y);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Converts a quaternion to roll, pitch and yaw
+    @param  q
+            The W, X, Y and Z components
+    @param  roll
+            Set to the rotation about X in degrees
+    @param  pitch
+            Set to the rotation about Y in degrees
+    @param  yaw
+            Set to the rotation about Z in degrees
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS::quaternionToEuler(const float q[4], float *roll,
+                                              float *pitch, float *yaw) {
+  float sin_pitch = 2 * (q[0] * q[2] - q[3] * q[1]);
+  if (sin_pitch > 1)
+    sin_pitch = 1;
+  if (sin_pitch < -1)
+    sin_pitch = -1;
+
+  *roll = atan2(2 * (q[0] * q[1] + q[2] * q[3]),
+                1 - 2 * (q[1] * q[1] + q[2] * q[2])) *
+          RAD_TO_DEG;
+  *pitch = asin(sin_pitch) * RAD_TO_DEG;
+  *yaw = atan2(2 * (q[0] * q[3] + q[1] * q[2]),
+               1 - 2 * (q[2] * q[2] + q[3] * q[3])) *
+         RAD_TO_DEG;
+}
+
+// fixed point helpers: products of values with 30 and 32 fractional bits
+static int32_t mul30(int32_t a, int32_t b) {
+  return ((int64_t)a * b) >> 30;
+}
+
+static int32_t mul32(int32_t a, int32_t b) {
+  return ((int64_t)a * b) >> 32;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the filter and resets the orientation to level
+    @param  sample_rate
+            The rate frames are passed to `update`, in Hz
+    @param  gyro_scale
+            The gyro sensitivity in LSB per deg/s, from `getGyroScale`
+    @param  kp
+            Proportional gain of the gravity correction
+    @param  ki
+            Integral gain, which slowly learns any remaining gyro bias.
+            0 disables it.
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS_Fixed::begin(float sample_rate, float gyro_scale,
+                                        float kp, float ki) {
+  float half_dt = 0.5 / sample_rate;
+
+  _gyro_k = DEG_TO_RAD / gyro_scale * half_dt * 1099511627776.0; // 2^40
+  _kp_k = kp * half_dt * 4294967296.0;                           // 2^32
+  _ki_k = ki * 2 * half_dt * 4294967296.0;
+  _half_dt = half_dt * 4294967296.0;
+
+  _q[0] = (int32_t)1 << 30;
+  _q[1] = _q[2] = _q[3] = 0;
+  _integral[0] = _integral[1] = _integral[2] = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Updates the orientation with one frame
+    @param  frame
+            A raw frame from `getSample` or the FIFO
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS_Fixed::update(const mpu6050_raw_frame_t *frame) {
+  int32_t *q = _q;
+  int32_t h[3]; // rotation over half a sample period, in radians
+
+  for (uint8_t i = 0; i < 3; i++)
+    h[i] = ((int64_t)frame->gyro[i] * _gyro_k) >> 10;
+
+  int32_t ax = frame->accel[0], ay = frame->accel[1], az = frame->accel[2];
+  if (ax != 0 || ay != 0 || az != 0) {
+    uint32_t norm = isqrt32((uint32_t)(ax * ax) + (uint32_t)(ay * ay) +
+                            (uint32_t)(az * az));
+    int64_t recip_norm = ((int64_t)1 << 45) / norm;
+    ax = (ax * recip_norm) >> 15;
+    ay = (ay * recip_norm) >> 15;
+    az = (az * recip_norm) >> 15;
+
+    // gravity direction predicted by the current orientation
+    int32_t vx = 2 * (mul30(q[1], q[3]) - mul30(q[0], q[2]));
+    int32_t vy = 2 * (mul30(q[0], q[1]) + mul30(q[2], q[3]));
+    int32_t vz = mul30(q[0], q[0]) - mul30(q[1], q[1]) - mul30(q[2], q[2]) +
+                 mul30(q[3], q[3]);
+
+    int32_t e[3] = {mul30(ay, vz) - mul30(az, vy),
+                    mul30(az, vx) - mul30(ax, vz),
+                    mul30(ax, vy) - mul30(ay, vx)};
+
+    for (uint8_t i = 0; i < 3; i++) {
+      if (_ki_k) {
+        _integral[i] += mul32(e[i], _ki_k);
+        h[i] += mul32(_integral[i], _half_dt);
+      }
+      h[i] += mul32(e[i], _kp_k);
+    }
+  }
+
+  int32_t qa = q[0], qb = q[1], qc = q[2];
+  q[0] += -mul30(qb, h[0]) - mul30(qc, h[1]) - mul30(q[3], h[2]);
+  q[1] += mul30(qa, h[0]) + mul30(qc, h[2]) - mul30(q[3], h[1]);
+  q[2] += mul30(qa, h[1]) - mul30(qb, h[2]) + mul30(q[3], h[0]);
+  q[3] += mul30(qa, h[2]) + mul30(qb, h[1]) - mul30(qc, h[0]);
+
+  // the norm stays close to 1, where one Newton step of 1 / sqrt(n) is
+  // 1.5 - n / 2
+  int32_t norm = mul30(q[0], q[0]) + mul30(q[1], q[1]) + mul30(q[2], q[2]) +
+                 mul30(q[3], q[3]);
+  int32_t scale = ((int32_t)3 << 29) - (norm >> 1);
+  for (uint8_t i = 0; i < 4; i++)
+    q[i] = mul30(q[i], scale);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Updates the orientation with a block of consecutive frames
+    @param  frames
+            Frames in the order they were sampled, such as a FIFO block
+    @param  count
+            The number of frames
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS_Fixed::update(const mpu6050_raw_frame_t *frames,
+                                         uint16_t count) {
+  for (uint16_t i = 0; i < count; i++)
+    update(&frames[i]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the orientation quaternion
+    @param  q
+            Filled with the W, X, Y and Z components
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS_Fixed::getQuaternion(float q[4]) {
+  for (uint8_t i = 0; i < 4; i++)
+    q[i] = _q[i] / 1073741824.0; // 2^30
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the orientation as Euler angles
+    @param  roll
+            Set to the rotation about X in degrees
+    @param  pitch
+            Set to the rotation about Y in degrees
+    @param  yaw
+            Set to the rotation about Z in degrees
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AHRS_Fixed::getEuler(float *roll, float *pitch,
+                                           float *yaw) {
+  float q[4];
+  getQuaternion(q);
+  Adafruit_MPU6050_AHRS::quaternionToEuler(q, roll, pitch, yaw);
+}
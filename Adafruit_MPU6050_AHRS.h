@@ -0,0 +1,81 @@
+/*!
+ *  @file Adafruit_MPU6050_AHRS.h
+ *
+ * 	Quaternion orientation filter for the MPU6050
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_AHRS_H
+#define _ADAFRUIT_MPU6050_AHRS_H
+
+#include <Adafruit_MPU6050.h>
+
+/*!
+ *    @brief  Class that tracks orientation as a quaternion with the Mahony
+ *            filter, using floating point math
+ *
+ *    The gyro is integrated every frame, and the difference between the
+ *    measured and estimated gravity directions is fed back through a
+ *    proportional and integral gain. Without a magnetometer, yaw drifts.
+ */
+class Adafruit_MPU6050_AHRS {
+public:
+  void begin(float sample_rate, float gyro_scale, float kp = 1.0,
+             float ki = 0.0);
+
+  void update(const mpu6050_raw_frame_t *frame);
+  void update(const mpu6050_raw_frame_t *frames, uint16_t count);
+
+  void getQuaternion(float q[4]);
+  void getEuler(float *roll, float *pitch, float *yaw);
+
+  static float invSqrt(float x);
+  static void quaternionToEuler(const float q[4], float *roll, float *pitch,
+                                float *yaw);
+
+private:
+  float _q[4] = {1, 0, 0, 0};
+  float _integral[3] = {0, 0, 0};
+  float _gyro_k = 0; // rad/s per raw gyro LSB
+  float _half_dt = 0;
+  float _kp = 1, _ki = 0, _dt = 0;
+};
+
+/*!
+ *    @brief  Class that runs the same filter as `Adafruit_MPU6050_AHRS`
+ *            in fixed point, for cores without an FPU
+ *
+ *    The quaternion is kept with 30 fractional bits. Only integer multiplies
+ *    and shifts are used per frame, apart from one division to normalize the
+ *    accelerometer.
+ */
+class Adafruit_MPU6050_AHRS_Fixed {
+public:
+  void begin(float sample_rate, float gyro_scale, float kp = 1.0,
+             float ki = 0.0);
+
+  void update(const mpu6050_raw_frame_t *frame);
+  void update(const mpu6050_raw_frame_t *frames, uint16_t count);
+
+  void getQuaternion(float q[4]);
+  void getEuler(float *roll, float *pitch, float *yaw);
+
+private:
+  int32_t _q[4] = {(int32_t)1 << 30, 0, 0, 0};
+  int32_t _integral[3] = {0, 0, 0}; // rad/s, 30 fractional bits
+  int32_t _gyro_k = 0;  // half-step rad per raw gyro LSB, 40 fractional bits
+  int32_t _kp_k = 0;    // kp * dt / 2, 32 fractional bits
+  int32_t _ki_k = 0;    // ki * dt, 32 fractional bits
+  int32_t _half_dt = 0; // dt / 2, 32 fractional bits
+};
+
+#endif
@@ -0,0 +1,89 @@
+/*!
+ *  @file Adafruit_MPU6050_Array.cpp
+ *
+ *  Paired access to two MPU6050s sharing one I2C bus
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+#include <Wire.h>
+
+#include <Adafruit_MPU6050_Array.h>
+
+static const uint8_t array_addresses[MPU6050_ARRAY_SIZE] = {
+    MPU6050_I2CADDR_DEFAULT, MPU6050_I2CADDR_ALT};
+
+/**************************************************************************/
+/*!
+    @brief  Sets up both devices. The reset and clock settling delays are
+            shared, so bringing up the pair takes as long as one device.
+    @param  wire
+            The Wire object both devices are connected to
+    @param  sensorID
+            The user-defined ID of the first device. The second device's
+            sensors are numbered from `sensorID + 3`.
+    @return True if both devices were found and initialized
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_Array::begin(TwoWire *wire, int32_t sensorID) {
+  for (uint8_t i = 0; i < MPU6050_ARRAY_SIZE; i++) {
+    if (!_devices[i]._connect(array_addresses[i], wire))
+      return false;
+  }
+
+  for (uint8_t i = 0; i < MPU6050_ARRAY_SIZE; i++)
+    _devices[i]._startReset();
+  for (uint8_t i = 0; i < MPU6050_ARRAY_SIZE; i++) {
+    while (_devices[i]._resetPending())
+      delay(1);
+  }
+  delay(100);
+
+  for (uint8_t i = 0; i < MPU6050_ARRAY_SIZE; i++)
+    _devices[i]._resetSignalPaths();
+  delay(100);
+
+  for (uint8_t i = 0; i < MPU6050_ARRAY_SIZE; i++)
+    _devices[i]._configure(sensorID + 3 * i);
+  delay(100);
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets one of the devices for configuration or individual reads
+    @param  index
+            0 for the device at `MPU6050_I2CADDR_DEFAULT`, 1 for the device
+            at `MPU6050_I2CADDR_ALT`
+    @return Pointer to the device, or NULL if `index` is out of range
+*/
+/**************************************************************************/
+Adafruit_MPU6050 *Adafruit_MPU6050_Array::getDevice(uint8_t index) {
+  if (index >= MPU6050_ARRAY_SIZE)
+    return NULL;
+  return &_devices[index];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads one sample from each device with back to back bursts
+    @param  pair
+            Pointer to a `mpu6050_sample_pair_t` to be filled
+    @return True if every device was read successfully
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_Array::getSamples(mpu6050_sample_pair_t *pair) {
+  uint32_t start = micros();
+  uint32_t last = start;
+  bool ok = true;
+
+  for (uint8_t i = 0; i < MPU6050_ARRAY_SIZE; i++) {
+    last = micros();
+    ok &= _devices[i].getSample(&pair->samples[i]);
+  }
+
+  pair->skew_us = last - start;
+  return ok;
+}
@@ -0,0 +1,49 @@
+/*!
+ *  @file Adafruit_MPU6050_Array.h
+ *
+ * 	Paired access to two MPU6050s sharing one I2C bus
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_ARRAY_H
+#define _ADAFRUIT_MPU6050_ARRAY_H
+
+#include <Adafruit_MPU6050.h>
+
+#define MPU6050_I2CADDR_ALT 0x69 ///< MPU6050 i2c address w/ AD0 high
+#define MPU6050_ARRAY_SIZE 2     ///< Devices in an `Adafruit_MPU6050_Array`
+
+/**
+ * @brief Samples read back to back from both devices of an array
+ */
+typedef struct {
+  mpu6050_sample_t samples[MPU6050_ARRAY_SIZE]; ///< One sample per device
+  uint16_t skew_us; ///< Time between the start of the first and last burst
+} mpu6050_sample_pair_t;
+
+/*!
+ *    @brief  Class that brings up and reads two MPU6050s, one at
+ *            `MPU6050_I2CADDR_DEFAULT` and one at `MPU6050_I2CADDR_ALT`,
+ *            on the same I2C bus
+ */
+class Adafruit_MPU6050_Array {
+public:
+  bool begin(TwoWire *wire = &Wire, int32_t sensorID = 0);
+
+  Adafruit_MPU6050 *getDevice(uint8_t index);
+  bool getSamples(mpu6050_sample_pair_t *pair);
+
+private:
+  Adafruit_MPU6050 _devices[MPU6050_ARRAY_SIZE];
+};
+
+#endif
@@ -0,0 +1,290 @@
+/*!
+ *  @file Adafruit_MPU6050_Biquad.cpp
+ *
+ *  Biquad IIR filter bank for MPU6050 samples
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_Biquad.h>
+#include <Adafruit_MPU6050_Math.h>
+
+#define BIQUAD_Q 28 // fractional bits of the fixed point coefficients
+
+/**************************************************************************/
+/*!
+    @brief  Calculates the coefficients of a section from the audio EQ
+            cookbook formulas
+    @param  coeffs
+            Where to store the coefficients
+    @param  type
+            The filter shape
+    @param  frequency
+            The corner or center frequency in Hz, below half the sample rate
+    @param  sample_rate
+            The rate the filtered frames are read at in Hz
+    @param  q
+            The quality factor. 0.7071 gives a Butterworth low or high pass;
+            higher values give a narrower band or notch.
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Biquad::design(mpu6050_biquad_t *coeffs,
+                                     mpu6050_biquad_type_t type,
+                                     float frequency, float sample_rate,
+                                     float q) {
+  float w0 = 2 * PI * frequency / sample_rate;
+  float cos_w0 = cos(w0);
+  float alpha = sin(w0) / (2 * q);
+  float a0 = 1 + alpha;
+
+  switch (type) {
+  case MPU6050_BIQUAD_LOWPASS:
+    coeffs->b1 = (1 - cos_w0) / a0;
+    coeffs->b0 = coeffs->b2 = coeffs->b1 / 2;
+    break;
+  case MPU6050_BIQUAD_HIGHPASS:
+    coeffs->b1 = -(1 + cos_w0) / a0;
+    coeffs->b0 = coeffs->b2 = -coeffs->b1 / 2;
+    break;
+  case MPU6050_BIQUAD_BANDPASS:
+    coeffs->b0 = alpha / a0;
+    coeffs->b1 = 0;
+    coeffs->b2 = -alpha / a0;
+    break;
+  case MPU6050_BIQUAD_NOTCH:
+    coeffs->b0 = coeffs->b2 = 1 / a0;
+    coeffs->b1 = -2 * cos_w0 / a0;
+    break;
+  }
+  coeffs->a1 = -2 * cos_w0 / a0;
+  coeffs->a2 = (1 - alpha) / a0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Appends a section to the cascade for one sensor
+    @param  group
+            The sensor the section filters
+    @param  coeffs
+            The section's coefficients, copied
+    @return True if added, false if the cascade already has
+            `MPU6050_BIQUAD_SECTIONS` sections
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_Biquad::addSection(mpu6050_filter_group_t group,
+                                         const mpu6050_biquad_t *coeffs) {
+  if (_sections[group] >= MPU6050_BIQUAD_SECTIONS)
+    return false;
+  uint8_t s = _sections[group]++;
+  _coeffs[group][s] = *coeffs;
+  memset(_state[group][s], 0, sizeof(_state[group][s]));
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Designs a section with `design` and appends it to the cascade
+            for one sensor
+    @param  group
+            The sensor the section filters
+    @param  type
+            The filter shape
+    @param  frequency
+            The corner or center frequency in Hz
+    @param  sample_rate
+            The rate the filtered frames are read at in Hz
+    @param  q
+            The quality factor
+    @return True if added, false if the cascade is full
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_Biquad::addSection(mpu6050_filter_group_t group,
+                                         mpu6050_biquad_type_t type,
+                                         float frequency, float sample_rate,
+                                         float q) {
+  mpu6050_biquad_t coeffs;
+  design(&coeffs, type, frequency, sample_rate, q);
+  return addSection(group, &coeffs);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Removes all sections, so frames pass through unchanged
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Biquad::clear(void) {
+  _sections[MPU6050_FILTER_ACCEL] = _sections[MPU6050_FILTER_GYRO] = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Zeroes the filter history, such as after a gap in the samples
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Biquad::reset(void) { memset(_state, 0, sizeof(_state)); }
+
+/**************************************************************************/
+/*!
+    @brief  Filters a block of frames in place. Each axis is run through
+            its whole cascade for the block with the filter state copied to
+            locals, so the inner loop only touches the coefficients.
+    @param  frames
+            The frames to filter
+    @param  count
+            The number of frames
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Biquad::process(mpu6050_raw_frame_t *frames,
+                                      uint16_t count) {
+  for (uint8_t g = 0; g < 2; g++) {
+    uint8_t sections = _sections[g];
+    if (!sections)
+      continue;
+
+    for (uint8_t a = 0; a < 3; a++) {
+      float z[MPU6050_BIQUAD_SECTIONS][2];
+      for (uint8_t s = 0; s < sections; s++) {
+        z[s][0] = _state[g][s][a][0];
+        z[s][1] = _state[g][s][a][1];
+      }
+
+      for (uint16_t i = 0; i < count; i++) {
+        int16_t *x = (g == MPU6050_FILTER_ACCEL ? frames[i].accel
+                                                : frames[i].gyro) +
+                     a;
+        float v = *x;
+        for (uint8_t s = 0; s < sections; s++) {
+          const mpu6050_biquad_t *c = &_coeffs[g][s];
+          float y = c->b0 * v + z[s][0];
+          z[s][0] = c->b1 * v - c->a1 * y + z[s][1];
+          z[s][1] = c->b2 * v - c->a2 * y;
+          v = y;
+        }
+        *x = clamp16(v + (v < 0 ? -0.5f : 0.5f));
+      }
+
+      for (uint8_t s = 0; s < sections; s++) {
+        _state[g][s][a][0] = z[s][0];
+        _state[g][s][a][1] = z[s][1];
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Appends a section to the cascade for one sensor
+    @param  group
+            The sensor the section filters
+    @param  coeffs
+            The section's coefficients, converted to fixed point
+    @return True if added, false if the cascade already has
+            `MPU6050_BIQUAD_SECTIONS` sections
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_Biquad_Fixed::addSection(mpu6050_filter_group_t group,
+                                               const mpu6050_biquad_t *coeffs) {
+  if (_sections[group] >= MPU6050_BIQUAD_SECTIONS)
+    return false;
+  uint8_t s = _sections[group]++;
+  const float *c = &coeffs->b0;
+  for (uint8_t i = 0; i < 5; i++)
+    _coeffs[group][s][i] = (int32_t)lround(c[i] * (1L << BIQUAD_Q));
+  memset(_state[group][s], 0, sizeof(_state[group][s]));
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Designs a section with `Adafruit_MPU6050_Biquad::design` and
+            appends it to the cascade for one sensor
+    @param  group
+            The sensor the section filters
+    @param  type
+            The filter shape
+    @param  frequency
+            The corner or center frequency in Hz
+    @param  sample_rate
+            The rate the filtered frames are read at in Hz
+    @param  q
+            The quality factor
+    @return True if added, false if the cascade is full
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_Biquad_Fixed::addSection(mpu6050_filter_group_t group,
+                                               mpu6050_biquad_type_t type,
+                                               float frequency,
+                                               float sample_rate, float q) {
+  mpu6050_biquad_t coeffs;
+  Adafruit_MPU6050_Biquad::design(&coeffs, type, frequency, sample_rate, q);
+  return addSection(group, &coeffs);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Removes all sections, so frames pass through unchanged
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Biquad_Fixed::clear(void) {
+  _sections[MPU6050_FILTER_ACCEL] = _sections[MPU6050_FILTER_GYRO] = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Zeroes the filter history, such as after a gap in the samples
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Biquad_Fixed::reset(void) {
+  memset(_state, 0, sizeof(_state));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Filters a block of frames in place
+    @param  frames
+            The frames to filter
+    @param  count
+            The number of frames
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Biquad_Fixed::process(mpu6050_raw_frame_t *frames,
+                                            uint16_t count) {
+  for (uint8_t g = 0; g < 2; g++) {
+    uint8_t sections = _sections[g];
+    if (!sections)
+      continue;
+
+    for (uint8_t a = 0; a < 3; a++) {
+      for (uint16_t i = 0; i < count; i++) {
+        int16_t *x = (g == MPU6050_FILTER_ACCEL ? frames[i].accel
+                                                : frames[i].gyro) +
+                     a;
+        int16_t v = *x;
+        for (uint8_t s = 0; s < sections; s++) {
+          const int32_t *c = _coeffs[g][s];
+          section_state_t *z = &_state[g][s][a];
+          // the outputs fed back are y + error / 2^28, so the fractions
+          // dropped from them go through the poles too
+          int64_t acc = (int64_t)c[0] * v + (int64_t)c[1] * z->x1 +
+                        (int64_t)c[2] * z->x2 - (int64_t)c[3] * z->y1 -
+                        (int64_t)c[4] * z->y2 -
+                        (((int64_t)c[3] * z->error1 +
+                          (int64_t)c[4] * z->error2) >>
+                         BIQUAD_Q);
+          int32_t y = (int32_t)(acc >> BIQUAD_Q);
+          z->x2 = z->x1;
+          z->x1 = v;
+          z->y2 = z->y1;
+          z->y1 = y;
+          z->error2 = z->error1;
+          z->error1 = (int32_t)(acc - (int64_t)y * ((int64_t)1 << BIQUAD_Q));
+          // rounded to the nearest LSB
+          v = clamp16(y + (z->error1 >> (BIQUAD_Q - 1)));
+        }
+        *x = v;
+      }
+    }
+  }
+}
@@ -0,0 +1,110 @@
+/*!
+ *  @file Adafruit_MPU6050_Biquad.h
+ *
+ * 	Biquad IIR filter bank for MPU6050 samples
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_BIQUAD_H
+#define _ADAFRUIT_MPU6050_BIQUAD_H
+
+#include <Adafruit_MPU6050.h>
+
+#define MPU6050_BIQUAD_SECTIONS 4 ///< Most sections per sensor in a bank
+
+/**
+ * @brief Filter shapes for `Adafruit_MPU6050_Biquad::design`
+ */
+typedef enum {
+  MPU6050_BIQUAD_LOWPASS,  ///< Second order low pass
+  MPU6050_BIQUAD_HIGHPASS, ///< Second order high pass
+  MPU6050_BIQUAD_BANDPASS, ///< Band pass with 0 dB gain at the center
+  MPU6050_BIQUAD_NOTCH,    ///< Band stop
+} mpu6050_biquad_type_t;
+
+/**
+ * @brief Which sensor of a frame a filter section applies to
+ */
+typedef enum {
+  MPU6050_FILTER_ACCEL, ///< The three accelerometer axes
+  MPU6050_FILTER_GYRO,  ///< The three gyro axes
+} mpu6050_filter_group_t;
+
+/*!
+ *    @brief  Coefficients of one biquad section, normalized so a0 is 1:
+ *            y = b0 x + b1 x[-1] + b2 x[-2] - a1 y[-1] - a2 y[-2]
+ */
+typedef struct {
+  float b0; ///< Input gain
+  float b1; ///< Gain of the previous input
+  float b2; ///< Gain of the input before that
+  float a1; ///< Feedback from the previous output
+  float a2; ///< Feedback from the output before that
+} mpu6050_biquad_t;
+
+/*!
+ *    @brief  Class that runs a cascade of biquad sections over the
+ *            accelerometer and gyro axes of raw frames, with a separate
+ *            cascade for each sensor, using floating point math
+ */
+class Adafruit_MPU6050_Biquad {
+public:
+  static void design(mpu6050_biquad_t *coeffs, mpu6050_biquad_type_t type,
+                     float frequency, float sample_rate, float q = 0.7071);
+
+  bool addSection(mpu6050_filter_group_t group, const mpu6050_biquad_t *coeffs);
+  bool addSection(mpu6050_filter_group_t group, mpu6050_biquad_type_t type,
+                  float frequency, float sample_rate, float q = 0.7071);
+  void clear(void);
+  void reset(void);
+
+  void process(mpu6050_raw_frame_t *frames, uint16_t count);
+
+private:
+  mpu6050_biquad_t _coeffs[2][MPU6050_BIQUAD_SECTIONS];
+  float _state[2][MPU6050_BIQUAD_SECTIONS][3][2]; // transposed direct form II
+  uint8_t _sections[2] = {0, 0};
+};
+
+/*!
+ *    @brief  Class that runs the same filter bank as
+ *            `Adafruit_MPU6050_Biquad` in fixed point, for cores without
+ *            an FPU
+ *
+ *    Coefficients are kept with 28 fractional bits and each section is
+ *    direct form I with a 64 bit accumulator. The fraction dropped from
+ *    each output is kept and fed back with it, so low corners, whose poles
+ *    sit close to 1, stay accurate.
+ */
+class Adafruit_MPU6050_Biquad_Fixed {
+public:
+  bool addSection(mpu6050_filter_group_t group, const mpu6050_biquad_t *coeffs);
+  bool addSection(mpu6050_filter_group_t group, mpu6050_biquad_type_t type,
+                  float frequency, float sample_rate, float q = 0.7071);
+  void clear(void);
+  void reset(void);
+
+  void process(mpu6050_raw_frame_t *frames, uint16_t count);
+
+private:
+  typedef struct {
+    int16_t x1, x2;
+    int32_t y1, y2;
+    int32_t error1, error2; // fractions of y1 and y2, with 28 bits
+  } section_state_t;
+
+  int32_t _coeffs[2][MPU6050_BIQUAD_SECTIONS][5]; // b0 b1 b2 a1 a2
+  section_state_t _state[2][MPU6050_BIQUAD_SECTIONS][3];
+  uint8_t _sections[2] = {0, 0};
+};
+
+#endif
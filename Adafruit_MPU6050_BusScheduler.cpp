@@ -0,0 +1,219 @@
+/*!
+ *  @file Adafruit_MPU6050_BusScheduler.cpp
+ *
+ *  Polling of MPU6050s spread over several I2C buses
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+#include <Wire.h>
+
+#include <Adafruit_MPU6050_BusScheduler.h>
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new scheduler using the default backend for
+            this core
+*/
+/**************************************************************************/
+Adafruit_MPU6050_BusScheduler::Adafruit_MPU6050_BusScheduler(void) {
+  _backend = &_default_backend;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds an initialized MPU6050 to the schedule
+    @param  mpu
+            The device, already started with `begin` on `wire`
+    @param  wire
+            The bus the device is connected to
+    @return The index of the device in the samples filled by `poll`, or -1
+            if the device or bus limit has been reached
+*/
+/**************************************************************************/
+int8_t Adafruit_MPU6050_BusScheduler::addDevice(Adafruit_MPU6050 *mpu,
+                                                TwoWire *wire) {
+  if (_count >= MPU6050_SCHEDULER_MAX_DEVICES)
+    return -1;
+
+  uint8_t bus = 0;
+  while (bus < _bus_count && _buses[bus] != wire)
+    bus++;
+  if (bus == _bus_count) {
+    if (_bus_count >= MPU6050_SCHEDULER_MAX_BUSES)
+      return -1;
+    _buses[_bus_count++] = wire;
+  }
+
+  _devices[_count] = mpu;
+  _device_bus[_count] = bus;
+  return _count++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the clock of every bus in the schedule
+    @param  frequency
+            The I2C clock in Hz. The MPU6050 supports up to 400 kHz.
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_BusScheduler::setBusClocks(uint32_t frequency) {
+  for (uint8_t bus = 0; bus < _bus_count; bus++)
+    _buses[bus]->setClock(frequency);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets how the reads of each bus are run, such as a backend built
+            on a core's asynchronous I2C driver
+    @param  backend
+            The backend to use, which must outlive the scheduler, or NULL
+            for the default backend of this core
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_BusScheduler::setBackend(
+    Adafruit_MPU6050_BusBackend *backend) {
+  _backend = backend ? backend : &_default_backend;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads one sample from every device. A job is started for each
+            bus and the call returns once all of them are done.
+    @param  samples
+            Array of at least `deviceCount()` samples, filled by device index
+    @return The number of devices read successfully
+*/
+/**************************************************************************/
+uint8_t Adafruit_MPU6050_BusScheduler::poll(mpu6050_sample_t *samples) {
+  if (_samples == 0)
+    _start_us = micros();
+
+  for (uint8_t bus = 0; bus < _bus_count; bus++) {
+    _jobs[bus].scheduler = this;
+    _jobs[bus].samples = samples;
+    _jobs[bus].bus = bus;
+    _jobs[bus].read = 0;
+    _backend->start(bus, _readBus, &_jobs[bus]);
+  }
+  _backend->wait();
+
+  uint8_t read = 0;
+  for (uint8_t bus = 0; bus < _bus_count; bus++)
+    read += _jobs[bus].read;
+
+  _samples += read;
+  return read;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the aggregate sample rate over all devices
+    @return Samples read per second since the first `poll` after
+            `resetStatistics`
+*/
+/**************************************************************************/
+float Adafruit_MPU6050_BusScheduler::getSamplesPerSecond(void) {
+  uint32_t elapsed = micros() - _start_us;
+  if (_samples == 0 || elapsed == 0)
+    return 0;
+  return _samples * 1000000.0 / elapsed;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Restarts the sample rate measurement
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_BusScheduler::resetStatistics(void) { _samples = 0; }
+
+/*!
+ *  @brief  Job that reads every device on one bus. Only touches the
+ *          devices and samples of its own bus, so jobs for different buses
+ *          can run at the same time.
+ */
+void Adafruit_MPU6050_BusScheduler::_readBus(void *arg) {
+  job_t *job = (job_t *)arg;
+  Adafruit_MPU6050_BusScheduler *scheduler = job->scheduler;
+
+  for (uint8_t i = 0; i < scheduler->_count; i++) {
+    if (scheduler->_device_bus[i] != job->bus)
+      continue;
+    if (scheduler->_devices[i]->getSample(&job->samples[i]))
+      job->read++;
+  }
+}
+
+#if defined(ESP32)
+/**************************************************************************/
+/*!
+    @brief  Stops the bus tasks
+*/
+/**************************************************************************/
+Adafruit_MPU6050_TaskBackend::~Adafruit_MPU6050_TaskBackend() {
+  for (uint8_t bus = 0; bus < MPU6050_SCHEDULER_MAX_BUSES; bus++) {
+    if (_tasks[bus])
+      vTaskDelete(_tasks[bus]);
+  }
+  if (_done)
+    vSemaphoreDelete(_done);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Hands a job to the task of its bus, creating the task the first
+            time. If the task can't be created the job runs in the caller.
+    @param  bus
+            The bus index
+    @param  job
+            The function to run
+    @param  arg
+            The argument to pass to `job`
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_TaskBackend::start(uint8_t bus, void (*job)(void *),
+                                         void *arg) {
+  if (!_done)
+    _done = xSemaphoreCreateCounting(MPU6050_SCHEDULER_MAX_BUSES, 0);
+
+  slot_t *slot = &_slots[bus];
+  slot->job = job;
+  slot->arg = arg;
+  slot->done = _done;
+
+  if (_done && !_tasks[bus]) {
+    xTaskCreate(_run, "mpu6050_bus", 2048, slot,
+                uxTaskPriorityGet(NULL), &_tasks[bus]);
+  }
+  if (!_done || !_tasks[bus]) {
+    job(arg);
+    return;
+  }
+  xTaskNotifyGive(_tasks[bus]);
+  _started++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Blocks until every job handed to a task has finished
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_TaskBackend::wait(void) {
+  for (; _started; _started--)
+    xSemaphoreTake(_done, portMAX_DELAY);
+}
+
+/*!
+ *  @brief  Body of a bus task: runs the slot's job each time it is
+ *          notified, then signals completion
+ */
+void Adafruit_MPU6050_TaskBackend::_run(void *param) {
+  slot_t *slot = (slot_t *)param;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    slot->job(slot->arg);
+    xSemaphoreGive(slot->done);
+  }
+}
+#endif
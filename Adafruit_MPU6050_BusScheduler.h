@@ -0,0 +1,151 @@
+/*!
+ *  @file Adafruit_MPU6050_BusScheduler.h
+ *
+ * 	Polling of MPU6050s spread over several I2C buses
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_BUSSCHEDULER_H
+#define _ADAFRUIT_MPU6050_BUSSCHEDULER_H
+
+#include <Adafruit_MPU6050.h>
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+#define MPU6050_SCHEDULER_MAX_BUSES 4    ///< Distinct TwoWire buses supported
+#define MPU6050_SCHEDULER_MAX_DEVICES 8  ///< Devices supported over all buses
+#define MPU6050_FAST_MODE_CLOCK 400000UL ///< Fastest I2C clock the chip allows
+
+/*!
+ *    @brief  Interface the scheduler uses to run the reads of each bus. A
+ *            backend may run the jobs of different buses at the same time;
+ *            the jobs of one bus never overlap.
+ */
+class Adafruit_MPU6050_BusBackend {
+public:
+  virtual ~Adafruit_MPU6050_BusBackend() {}
+  /*!  @brief Starts the job that reads every device on one bus
+   *   @param bus The bus index, below `MPU6050_SCHEDULER_MAX_BUSES`
+   *   @param job The function to run
+   *   @param arg The argument to pass to `job` */
+  virtual void start(uint8_t bus, void (*job)(void *), void *arg) = 0;
+  /*!  @brief Blocks until every job started since the last `wait` is done */
+  virtual void wait(void) = 0;
+};
+
+/*!
+ *    @brief  Backend that runs each job in the caller as it is started, so
+ *            buses are read one after the other. Works on every core.
+ */
+class Adafruit_MPU6050_SequentialBackend : public Adafruit_MPU6050_BusBackend {
+public:
+  /*!  @brief Runs the job straight away
+   *   @param bus The bus index, unused
+   *   @param job The function to run
+   *   @param arg The argument to pass to `job` */
+  void start(uint8_t bus, void (*job)(void *), void *arg) override {
+    (void)bus;
+    job(arg);
+  }
+  /*!  @brief Does nothing, since jobs finish in `start` */
+  void wait(void) override {}
+};
+
+#if defined(ESP32)
+/*!
+ *    @brief  Backend that gives every bus its own FreeRTOS task, so the
+ *            transfers on different buses run at the same time. Tasks are
+ *            created on first use and run at the caller's priority.
+ */
+class Adafruit_MPU6050_TaskBackend : public Adafruit_MPU6050_BusBackend {
+public:
+  ~Adafruit_MPU6050_TaskBackend();
+  void start(uint8_t bus, void (*job)(void *), void *arg) override;
+  void wait(void) override;
+
+private:
+  typedef struct {
+    void (*job)(void *);
+    void *arg;
+    SemaphoreHandle_t done;
+  } slot_t;
+
+  static void _run(void *param);
+
+  TaskHandle_t _tasks[MPU6050_SCHEDULER_MAX_BUSES] = {NULL};
+  slot_t _slots[MPU6050_SCHEDULER_MAX_BUSES];
+  SemaphoreHandle_t _done = NULL;
+  uint8_t _started = 0;
+};
+#endif
+
+/*!
+ *    @brief  Class that polls MPU6050s on several TwoWire buses. The devices
+ *            of each bus are read in turn by a job per bus, and the jobs run
+ *            through a backend: one FreeRTOS task per bus on ESP32, so the
+ *            buses transfer concurrently, and one after the other elsewhere
+ *            unless another backend is set.
+ */
+class Adafruit_MPU6050_BusScheduler {
+public:
+  Adafruit_MPU6050_BusScheduler(void);
+
+  int8_t addDevice(Adafruit_MPU6050 *mpu, TwoWire *wire);
+  void setBusClocks(uint32_t frequency = MPU6050_FAST_MODE_CLOCK);
+  void setBackend(Adafruit_MPU6050_BusBackend *backend);
+
+  uint8_t poll(mpu6050_sample_t *samples);
+
+  float getSamplesPerSecond(void);
+  void resetStatistics(void);
+
+  /** @brief Gets the number of devices added to the scheduler
+      @returns The device count */
+  uint8_t deviceCount(void) { return _count; }
+  /** @brief Gets the number of distinct buses in use
+      @returns The bus count */
+  uint8_t busCount(void) { return _bus_count; }
+
+private:
+  typedef struct {
+    Adafruit_MPU6050_BusScheduler *scheduler;
+    mpu6050_sample_t *samples;
+    uint8_t bus;
+    uint8_t read;
+  } job_t;
+
+  static void _readBus(void *arg);
+
+  TwoWire *_buses[MPU6050_SCHEDULER_MAX_BUSES];
+  uint8_t _bus_count = 0;
+  job_t _jobs[MPU6050_SCHEDULER_MAX_BUSES];
+
+  Adafruit_MPU6050 *_devices[MPU6050_SCHEDULER_MAX_DEVICES];
+  uint8_t _device_bus[MPU6050_SCHEDULER_MAX_DEVICES];
+  uint8_t _count = 0;
+
+  Adafruit_MPU6050_BusBackend *_backend = NULL;
+#if defined(ESP32)
+  Adafruit_MPU6050_TaskBackend _default_backend;
+#else
+  Adafruit_MPU6050_SequentialBackend _default_backend;
+#endif
+
+  uint32_t _samples = 0;
+  uint32_t _start_us = 0;
+};
+
+#endif
@@ -0,0 +1,277 @@
+/*!
+ *  @file Adafruit_MPU6050_Calibration.cpp
+ *
+ *  Multi-position calibration for the MPU6050
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_Calibration.h>
+#include <Adafruit_MPU6050_Math.h>
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new six-position calibrator
+    @param  mpu
+            The device to capture readings from, or NULL if readings will
+            only be added with `addReading`
+*/
+/**************************************************************************/
+Adafruit_MPU6050_AccelCalibrator::Adafruit_MPU6050_AccelCalibrator(
+    Adafruit_MPU6050 *mpu) {
+  _mpu = mpu;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Averages the accelerometer while the sensor is held still in one
+            orientation. Any calibration set on the device is ignored.
+    @param  orientation
+            The axis currently pointing up or down
+    @param  samples
+            The number of samples to average
+    @return True if the reading was stored
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_AccelCalibrator::capture(
+    mpu6050_orientation_t orientation, uint16_t samples) {
+  if (!_mpu || samples == 0)
+    return false;
+
+  int32_t sum[3] = {0, 0, 0};
+  uint16_t count = 0;
+  mpu6050_sample_t sample;
+  for (uint16_t n = 0; n < samples; n++) {
+    if (!_mpu->getSample(&sample))
+      continue;
+    for (uint8_t i = 0; i < 3; i++)
+      sum[i] += sample.raw.accel[i];
+    count++;
+  }
+  if (count == 0)
+    return false;
+
+  float scale = _mpu->getAccelerometerScale();
+  float reading[3];
+  for (uint8_t i = 0; i < 3; i++)
+    reading[i] = sum[i] / (scale * count);
+  addReading(orientation, reading);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Stores an averaged reading for one orientation, such as one
+            loaded from a log
+    @param  orientation
+            The axis that was pointing up or down
+    @param  reading
+            The uncorrected X, Y and Z acceleration in g
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_AccelCalibrator::addReading(
+    mpu6050_orientation_t orientation, const float reading[3]) {
+  for (uint8_t i = 0; i < 3; i++)
+    _readings[orientation][i] = reading[i];
+  _captured |= 1 << orientation;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Solves for the correction from the six readings.
+            With `reading = A * true + bias`, each up/down pair gives one
+            column of A from its difference and an estimate of the bias from
+            its mean. The correction matrix is the inverse of A.
+    @param  cal
+            Filled with the solved calibration
+    @return True if all six readings were present and the result is usable
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_AccelCalibrator::solve(mpu6050_accel_cal_t *cal) {
+  if (!isComplete())
+    return false;
+
+  float a[3][3];
+  for (uint8_t i = 0; i < 3; i++) {
+    cal->bias[i] = 0;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      const float *up = _readings[2 * axis];
+      const float *down = _readings[2 * axis + 1];
+      a[i][axis] = (up[i] - down[i]) / 2;
+      cal->bias[i] += (up[i] + down[i]) / 6;
+    }
+  }
+
+  float det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+              a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+              a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+  // a sensor this far off, or a repeated orientation, can't be corrected
+  if (fabs(det) < 0.1)
+    return false;
+
+  float (*m)[3] = cal->matrix;
+  m[0][0] = (a[1][1] * a[2][2] - a[1][2] * a[2][1]) / det;
+  m[0][1] = (a[0][2] * a[2][1] - a[0][1] * a[2][2]) / det;
+  m[0][2] = (a[0][1] * a[1][2] - a[0][2] * a[1][1]) / det;
+  m[1][0] = (a[1][2] * a[2][0] - a[1][0] * a[2][2]) / det;
+  m[1][1] = (a[0][0] * a[2][2] - a[0][2] * a[2][0]) / det;
+  m[1][2] = (a[0][2] * a[1][0] - a[0][0] * a[1][2]) / det;
+  m[2][0] = (a[1][0] * a[2][1] - a[1][1] * a[2][0]) / det;
+  m[2][1] = (a[0][1] * a[2][0] - a[0][0] * a[2][1]) / det;
+  m[2][2] = (a[0][0] * a[1][1] - a[0][1] * a[1][0]) / det;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new temperature compensation fitter
+    @param  temp_min
+            Raw temperature of the first table point
+    @param  temp_shift
+            Log2 of the raw temperature between table points. The default
+            of 12 spaces points about 12C apart, covering -20C to 64C.
+*/
+/**************************************************************************/
+Adafruit_MPU6050_TempCompFitter::Adafruit_MPU6050_TempCompFitter(
+    int16_t temp_min, uint8_t temp_shift) {
+  _temp_min = temp_min;
+  _temp_shift = temp_shift;
+  memset(_weight, 0, sizeof(_weight));
+  memset(_cross, 0, sizeof(_cross));
+  memset(_accel_sum, 0, sizeof(_accel_sum));
+  memset(_gyro_sum, 0, sizeof(_gyro_sum));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds one sample of the sweep. The sensor must be still and in
+            the same orientation throughout, with no temperature
+            compensation set on the device. Each sample is shared between
+            the two table points either side of its temperature, in the
+            proportions the table is interpolated with, so `fit` finds the
+            table that best matches the samples as the driver applies it.
+    @param  frame
+            A raw frame from `getSample` or the FIFO
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_TempCompFitter::addSample(
+    const mpu6050_raw_frame_t *frame) {
+  int32_t w1;
+  uint8_t p = _segmentFor(frame->temperature, &w1);
+  int32_t w0 = 256 - w1;
+
+  // sums for the least squares fit; an int64_t holds years of samples
+  _weight[p] += w0 * w0;
+  _weight[p + 1] += w1 * w1;
+  _cross[p] += w0 * w1;
+  for (uint8_t i = 0; i < 3; i++) {
+    _accel_sum[p][i] += (int64_t)w0 * frame->accel[i];
+    _accel_sum[p + 1][i] += (int64_t)w1 * frame->accel[i];
+    _gyro_sum[p][i] += (int64_t)w0 * frame->gyro[i];
+    _gyro_sum[p + 1][i] += (int64_t)w1 * frame->gyro[i];
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Builds the table from the samples added so far, by least
+            squares. Points with no samples nearby are interpolated
+            between the points that have them, or copy the nearest one
+            past the ends of the sweep.
+            Gyro biases are absolute, since the sensor was not rotating.
+            Accelerometer biases are relative to the reading at
+            `accel_reference`, so gravity and any offset already trimmed at
+            that temperature are left alone.
+    @param  table
+            Filled with the fitted table
+    @param  accel_reference
+            Raw temperature at which the accelerometer bias is taken as zero
+    @return True if at least one sample was added
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_TempCompFitter::fit(mpu6050_temp_comp_t *table,
+                                          int16_t accel_reference) {
+  const uint8_t points = MPU6050_TEMP_COMP_POINTS;
+  table->temp_min = _temp_min;
+  table->temp_shift = _temp_shift;
+
+  float most = 0;
+  for (uint8_t p = 0; p < points; p++) {
+    if (_weight[p] > most)
+      most = _weight[p];
+  }
+  if (most == 0)
+    return false;
+
+  // A faint pull between neighbouring points fills the points with no
+  // samples, and keeps the system solvable when samples only sit midway
+  // between two points. It is too weak to move the points that have them.
+  float smooth = most * 1e-5;
+
+  // tridiagonal normal equations, solved by the Thomas algorithm;
+  // bias[p][0..2] is accel and bias[p][3..5] gyro
+  float diag[MPU6050_TEMP_COMP_POINTS], upper[MPU6050_TEMP_COMP_POINTS];
+  float bias[MPU6050_TEMP_COMP_POINTS][6];
+  for (uint8_t p = 0; p < points; p++) {
+    diag[p] = _weight[p] + smooth * ((p > 0) + (p < points - 1));
+    float lower = 0;
+    if (p > 0) {
+      lower = _cross[p - 1] - smooth;
+      diag[p] -= lower * upper[p - 1];
+    }
+    if (p < points - 1)
+      upper[p] = (_cross[p] - smooth) / diag[p];
+    // the weights in the sums of squares are scaled by 256 twice
+    for (uint8_t i = 0; i < 3; i++) {
+      bias[p][i] = _accel_sum[p][i] * 256.0f;
+      bias[p][i + 3] = _gyro_sum[p][i] * 256.0f;
+    }
+    for (uint8_t i = 0; i < 6; i++) {
+      if (p > 0)
+        bias[p][i] -= lower * bias[p - 1][i];
+      bias[p][i] /= diag[p];
+    }
+  }
+  for (int8_t p = points - 2; p >= 0; p--) {
+    for (uint8_t i = 0; i < 6; i++)
+      bias[p][i] -= upper[p] * bias[p + 1][i];
+  }
+
+  int32_t w1;
+  uint8_t ref = _segmentFor(accel_reference, &w1);
+  float reference[3];
+  for (uint8_t i = 0; i < 3; i++)
+    reference[i] = bias[ref][i] + (bias[ref + 1][i] - bias[ref][i]) * w1 / 256;
+
+  for (uint8_t p = 0; p < points; p++) {
+    for (uint8_t i = 0; i < 3; i++) {
+      table->accel[p][i] = clamp16(roundf(bias[p][i] - reference[i]));
+      table->gyro[p][i] = clamp16(roundf(bias[p][i + 3]));
+    }
+  }
+  return true;
+}
+
+/*!  @brief Finds the table segment a temperature is interpolated in, as
+ *   the driver's compensation does
+ *   @param temperature The raw temperature
+ *   @param weight Set to the weight of the segment's upper point, out of
+ *   256; the lower point has the rest
+ *   @returns The index of the segment's lower point
+ */
+uint8_t Adafruit_MPU6050_TempCompFitter::_segmentFor(int16_t temperature,
+                                                     int32_t *weight) {
+  int32_t offset = (int32_t)temperature - _temp_min;
+  if (offset < 0)
+    offset = 0;
+  int32_t index = offset >> _temp_shift;
+  if (index >= MPU6050_TEMP_COMP_POINTS - 1) {
+    *weight = 256;
+    return MPU6050_TEMP_COMP_POINTS - 2;
+  }
+  int32_t frac = offset - (index << _temp_shift);
+  *weight = ((int64_t)frac << 8) >> _temp_shift;
+  return index;
+}
@@ -0,0 +1,87 @@
+/*!
+ *  @file Adafruit_MPU6050_Calibration.h
+ *
+ * 	Multi-position calibration for the MPU6050
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_CALIBRATION_H
+#define _ADAFRUIT_MPU6050_CALIBRATION_H
+
+#include <Adafruit_MPU6050.h>
+
+/**
+ * @brief Orientations used by the six-position calibration
+ *
+ * Names give the sensor axis that points up, away from the ground.
+ */
+typedef enum {
+  MPU6050_X_UP,   ///< +X axis up
+  MPU6050_X_DOWN, ///< +X axis down
+  MPU6050_Y_UP,   ///< +Y axis up
+  MPU6050_Y_DOWN, ///< +Y axis down
+  MPU6050_Z_UP,   ///< +Z axis up, sensor lying flat
+  MPU6050_Z_DOWN, ///< +Z axis down, sensor upside down
+} mpu6050_orientation_t;
+
+/*!
+ *    @brief  Class that solves accelerometer bias, scale and cross-axis
+ *            correction from readings taken with each axis pointing up and
+ *            then down
+ */
+class Adafruit_MPU6050_AccelCalibrator {
+public:
+  Adafruit_MPU6050_AccelCalibrator(Adafruit_MPU6050 *mpu = NULL);
+
+  bool capture(mpu6050_orientation_t orientation, uint16_t samples = 500);
+  void addReading(mpu6050_orientation_t orientation, const float reading[3]);
+
+  /** @brief Checks whether all six orientations have a reading
+      @returns True when `solve` can be called */
+  bool isComplete(void) { return _captured == 0x3F; }
+
+  bool solve(mpu6050_accel_cal_t *cal);
+
+private:
+  Adafruit_MPU6050 *_mpu = NULL;
+  float _readings[6][3];
+  uint8_t _captured = 0;
+};
+
+#define MPU6050_TEMP_RAW_MINUS_20C -19220 ///< Raw temperature at -20C
+#define MPU6050_TEMP_RAW_25C -3920        ///< Raw temperature at 25C
+
+/*!
+ *    @brief  Class that builds a `mpu6050_temp_comp_t` table from samples
+ *            logged while a stationary sensor is swept over temperature
+ */
+class Adafruit_MPU6050_TempCompFitter {
+public:
+  Adafruit_MPU6050_TempCompFitter(
+      int16_t temp_min = MPU6050_TEMP_RAW_MINUS_20C, uint8_t temp_shift = 12);
+
+  void addSample(const mpu6050_raw_frame_t *frame);
+  bool fit(mpu6050_temp_comp_t *table,
+           int16_t accel_reference = MPU6050_TEMP_RAW_25C);
+
+private:
+  int16_t _temp_min;
+  uint8_t _temp_shift;
+  int64_t _weight[MPU6050_TEMP_COMP_POINTS];
+  int64_t _cross[MPU6050_TEMP_COMP_POINTS - 1];
+  int64_t _accel_sum[MPU6050_TEMP_COMP_POINTS][3];
+  int64_t _gyro_sum[MPU6050_TEMP_COMP_POINTS][3];
+
+  uint8_t _segmentFor(int16_t temperature, int32_t *weight);
+};
+
+#endif
@@ -0,0 +1,127 @@
+/*!
+ *  @file Adafruit_MPU6050_Complementary.cpp
+ *
+ *  Complementary filter roll and pitch estimator for the MPU6050
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_Complementary.h>
+
+static float wrap180(float angle) {
+  if (angle > 180)
+    return angle - 360;
+  if (angle < -180)
+    return angle + 360;
+  return angle;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the filter. The first update starts from the
+            accelerometer's angles.
+    @param  sample_rate
+            The rate frames are passed to `update`, in Hz
+    @param  gyro_scale
+            The gyro sensitivity in LSB per deg/s, from `getGyroScale`
+    @param  crossover
+            The frequency in Hz below which the accelerometer is trusted
+            over the gyro
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Complementary::begin(float sample_rate, float gyro_scale,
+                                           float crossover) {
+  _sample_rate = sample_rate;
+  _gyro_step = 1 / (sample_rate * gyro_scale);
+  _started = false;
+  setCrossover(crossover);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Changes the crossover frequency without resetting the estimate
+    @param  crossover
+            The frequency in Hz below which the accelerometer is trusted
+            over the gyro
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Complementary::setCrossover(float crossover) {
+  float tau = 1 / (TWO_PI * crossover);
+  _alpha = tau / (tau + 1 / _sample_rate);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Updates the estimate with one frame. Takes the same path every
+            call, with no allocation.
+    @param  frame
+            A raw frame from `getSample` or the FIFO
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Complementary::update(const mpu6050_raw_frame_t *frame) {
+  float ax = frame->accel[0], ay = frame->accel[1], az = frame->accel[2];
+
+  // the accelerometer scale cancels out of both angles
+  float accel_roll = fastAtan2(ay, az) * RAD_TO_DEG;
+  float accel_pitch = fastAtan2(-ax, sqrt(ay * ay + az * az)) * RAD_TO_DEG;
+
+  if (!_started) {
+    _roll = accel_roll;
+    _pitch = accel_pitch;
+    _started = true;
+    return;
+  }
+
+  float roll = _roll + frame->gyro[0] * _gyro_step;
+  float pitch = _pitch + frame->gyro[1] * _gyro_step;
+
+  // blend on the difference so roll can cross +/- 180 smoothly
+  _roll = wrap180(roll + (1 - _alpha) * wrap180(accel_roll - roll));
+  _pitch = pitch + (1 - _alpha) * (accel_pitch - pitch);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Updates the estimate with a block of consecutive frames
+    @param  frames
+            Frames in the order they were sampled, such as a FIFO block
+    @param  count
+            The number of frames
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Complementary::update(const mpu6050_raw_frame_t *frames,
+                                            uint16_t count) {
+  for (uint16_t i = 0; i < count; i++)
+    update(&frames[i]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Approximates `atan2` to within about 0.0015 radians with a short
+            polynomial, several times faster than the library
+            call on cores without a double precision FPU
+    @param  y
+            The y coordinate
+    @param  x
+            The x coordinate
+    @return The angle of (x, y) in radians, -PI to PI
+*/
+/**************************************************************************/
+float Adafruit_MPU6050_Complementary::fastAtan2(float y, float x) {
+  float abs_y = fabs(y), abs_x = fabs(x);
+  if (abs_x == 0 && abs_y == 0)
+    return 0;
+
+  // atan(z) for z in [0, 1], with the larger magnitude as divisor
+  bool swapped = abs_y > abs_x;
+  float z = swapped ? abs_x / abs_y : abs_y / abs_x;
+  float angle = (float)(PI / 4) * z - z * (z - 1) * (0.2447f + 0.0663f * z);
+
+  if (swapped)
+    angle = (float)HALF_PI - angle;
+  if (x < 0)
+    angle = (float)PI - angle;
+  return y < 0 ? -angle : angle;
+}
@@ -0,0 +1,52 @@
+/*!
+ *  @file Adafruit_MPU6050_Complementary.h
+ *
+ * 	Complementary filter roll and pitch estimator for the MPU6050
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_COMPLEMENTARY_H
+#define _ADAFRUIT_MPU6050_COMPLEMENTARY_H
+
+#include <Adafruit_MPU6050.h>
+
+/*!
+ *    @brief  Class that estimates roll and pitch from raw frames by
+ *            integrating the gyro and pulling the result towards the
+ *            accelerometer's gravity direction below a crossover frequency
+ */
+class Adafruit_MPU6050_Complementary {
+public:
+  void begin(float sample_rate, float gyro_scale, float crossover = 0.5);
+  void setCrossover(float crossover);
+
+  void update(const mpu6050_raw_frame_t *frame);
+  void update(const mpu6050_raw_frame_t *frames, uint16_t count);
+
+  /** @brief Gets the roll angle, rotation about the X axis
+      @returns Roll in degrees, -180 to 180 */
+  float getRoll(void) { return _roll; }
+  /** @brief Gets the pitch angle, rotation about the Y axis
+      @returns Pitch in degrees, -90 to 90 */
+  float getPitch(void) { return _pitch; }
+
+  static float fastAtan2(float y, float x);
+
+private:
+  float _sample_rate = 100;
+  float _gyro_step = 0; // degrees per raw gyro LSB per sample
+  float _alpha = 0.98;  // weight of the gyro prediction
+  float _roll = 0, _pitch = 0;
+  bool _started = false;
+};
+
+#endif
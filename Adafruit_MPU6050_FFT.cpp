@@ -0,0 +1,416 @@
+/*!
+ *  @file Adafruit_MPU6050_FFT.cpp
+ *
+ *  Vibration spectrum of MPU6050 accelerometer blocks
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_FFT.h>
+#include <Adafruit_MPU6050_Math.h>
+
+// A quarter wave of sin(2 pi i / 1024) * 32767, enough for every twiddle
+// factor of every size up to MPU6050_FFT_MAX_SIZE
+static const int16_t sine_table[257] PROGMEM = {
+    0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809,
+    2009, 2210, 2410, 2611, 2811, 3012, 3212, 3412, 3612, 3811,
+    4011, 4210, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800,
+    5998, 6195, 6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767,
+    7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319, 9512, 9704,
+    9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605,
+    11793, 11980, 12167, 12353, 12539, 12725, 12910, 13094, 13279, 13462,
+    13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+    15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018,
+    17189, 17360, 17530, 17700, 17869, 18037, 18204, 18371, 18537, 18703,
+    18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317,
+    20475, 20631, 20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856,
+    22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027, 23170, 23311,
+    23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680,
+    24811, 24942, 25072, 25201, 25329, 25456, 25582, 25708, 25832, 25955,
+    26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+    27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208,
+    28310, 28411, 28510, 28609, 28706, 28803, 28898, 28992, 29085, 29177,
+    29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037,
+    30117, 30195, 30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783,
+    30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297, 31356, 31414,
+    31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926,
+    31971, 32014, 32057, 32098, 32137, 32176, 32213, 32250, 32285, 32318,
+    32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+    32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737,
+    32745, 32752, 32757, 32761, 32765, 32766, 32767
+};
+
+// magnitude above which a butterfly stage could overflow 16 bits
+#define FFT_HEADROOM 16000L
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new spectrum analyser
+    @param  buffer
+            Caller-owned storage for `size` samples, also used for the
+            transform and the magnitudes
+    @param  size
+            The transform size: 256, 512 or 1024
+*/
+/**************************************************************************/
+Adafruit_MPU6050_FFT::Adafruit_MPU6050_FFT(int16_t *buffer, uint16_t size) {
+  _buffer = buffer;
+  _size = size;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the analysis and starts collecting
+    @param  sample_rate
+            The rate the frames are read at in Hz
+    @param  accel_scale
+            The accelerometer sensitivity in LSB per g, from
+            `getAccelerometerScale`
+    @param  axis
+            The accelerometer axis to analyse, 0 to 2 for X to Z
+    @param  window
+            The window applied before the transform
+    @return True if the size is supported and the axis is valid
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_FFT::begin(float sample_rate, float accel_scale,
+                                 uint8_t axis, mpu6050_fft_window_t window) {
+  if (_size != 256 && _size != 512 && _size != 1024)
+    return false;
+  if (axis > 2)
+    return false;
+
+  _sample_rate = sample_rate;
+  _accel_scale = accel_scale;
+  _axis = axis;
+  _window_type = window;
+  _filled = 0;
+  _ready = false;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copies the analysed axis of a block of frames into the buffer.
+            Frames past a full buffer are dropped, since each spectrum is
+            taken from its own block of samples.
+    @param  frames
+            The frames, such as from `readFifoFrames`
+    @param  count
+            The number of frames
+    @return True once the buffer is full and `compute` can run
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_FFT::addFrames(const mpu6050_raw_frame_t *frames,
+                                     uint16_t count) {
+  if (_ready) {
+    _ready = false;
+    _filled = 0;
+  }
+  while (count-- && _filled < _size)
+    _buffer[_filled++] = (frames++)->accel[_axis];
+  return _filled == _size;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Removes the mean, applies the window and transforms a full
+            buffer into magnitudes
+    @return True if the spectrum was computed, false if the buffer is not
+            full yet
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_FFT::compute(void) {
+  if (_filled < _size || _ready)
+    return false;
+
+  _window();
+  _transform();
+  _split();
+
+  // magnitude of bin k overwrites word k, which has already been read
+  _buffer[0] = 0; // DC, removed with the mean
+  for (uint16_t k = 1; k < _size / 2; k++) {
+    int32_t re = _buffer[2 * k], im = _buffer[2 * k + 1];
+    _buffer[k] = isqrt32((uint32_t)(re * re) + (uint32_t)(im * im));
+  }
+  _ready = true;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the center frequency of a bin
+    @param  bin
+            The bin, 0 to `size / 2 - 1`
+    @return The frequency in Hz
+*/
+/**************************************************************************/
+float Adafruit_MPU6050_FFT::getBinFrequency(uint16_t bin) {
+  return bin * _sample_rate / _size;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the amplitude of a sine wave at a bin's frequency, with the
+            window's gain taken out
+    @param  bin
+            The bin, 0 to `size / 2 - 1`
+    @return The amplitude in g, or 0 if no spectrum has been computed
+*/
+/**************************************************************************/
+float Adafruit_MPU6050_FFT::getAmplitude(uint16_t bin) {
+  // coherent gain of each window
+  static const float gain[] = {1.0, 0.5, 0.54};
+
+  if (!_ready || bin >= _size / 2)
+    return 0;
+  return 2 * ldexp((uint16_t)_buffer[bin], _shift) /
+         (_size * gain[_window_type] * _accel_scale);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Finds the largest local maxima of the spectrum. Each frequency
+            is refined between bins with a parabola through the peak and
+            its neighbours.
+    @param  frequencies
+            Where to store the peak frequencies in Hz, largest peak first
+    @param  amplitudes
+            Where to store the peak amplitudes in g. May be NULL.
+    @param  count
+            The most peaks to report
+    @return The number of peaks stored
+*/
+/**************************************************************************/
+uint8_t Adafruit_MPU6050_FFT::getPeaks(float *frequencies, float *amplitudes,
+                                       uint8_t count) {
+  uint16_t *mag = (uint16_t *)_buffer;
+  uint8_t found = 0;
+
+  if (!_ready)
+    return 0;
+
+  // keep the bins of the largest maxima in frequencies, largest first
+  for (uint16_t k = 1; k < _size / 2 - 1; k++) {
+    if (mag[k] <= mag[k - 1] || mag[k] < mag[k + 1])
+      continue;
+
+    uint8_t i = found;
+    while (i > 0 && mag[k] > mag[(uint16_t)frequencies[i - 1]]) {
+      if (i < count)
+        frequencies[i] = frequencies[i - 1];
+      i--;
+    }
+    if (i < count) {
+      frequencies[i] = k;
+      if (found < count)
+        found++;
+    }
+  }
+
+  for (uint8_t i = 0; i < found; i++) {
+    uint16_t k = frequencies[i];
+    float a = mag[k - 1], b = mag[k], c = mag[k + 1];
+    float offset = 0.5 * (a - c) / (a - 2 * b + c);
+
+    frequencies[i] = getBinFrequency(k) + offset * _sample_rate / _size;
+    if (amplitudes)
+      amplitudes[i] = getAmplitude(k) * (b - 0.25 * (a - c) * offset) / b;
+  }
+  return found;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the mean square acceleration in a frequency band, with the
+            window's power gain taken out
+    @param  low
+            The lowest frequency in the band in Hz
+    @param  high
+            The highest frequency in the band in Hz
+    @return The mean square in g squared. Its square root is the RMS
+            vibration in the band.
+*/
+/**************************************************************************/
+float Adafruit_MPU6050_FFT::getBandEnergy(float low, float high) {
+  // mean of the squared window
+  static const float power_gain[] = {1.0, 0.375, 0.3974};
+  uint16_t *mag = (uint16_t *)_buffer;
+  float sum = 0;
+
+  if (!_ready)
+    return 0;
+
+  for (uint16_t k = 1; k < _size / 2; k++) {
+    float f = getBinFrequency(k);
+    if (f >= low && f <= high)
+      sum += (float)mag[k] * mag[k];
+  }
+  float scale = ldexp(1, _shift) / (_size * _accel_scale);
+  return 2 * sum * scale * scale / power_gain[_window_type];
+}
+
+/*!
+ *  @brief  Removes the mean and applies the window, then scales the samples
+ *          to use as much of 16 bits as the transform allows
+ */
+void Adafruit_MPU6050_FFT::_window(void) {
+  int32_t sum = 0;
+  for (uint16_t n = 0; n < _size; n++)
+    sum += _buffer[n];
+  int16_t mean = sum / _size;
+
+  // n / size of a full turn is n * (1024 / size) in table steps
+  uint8_t step = MPU6050_FFT_MAX_SIZE / _size;
+  uint16_t peak = 0;
+  for (uint16_t n = 0; n < _size; n++) {
+    int32_t x = (int32_t)_buffer[n] - mean; // up to 17 bits
+    int32_t c = _sin(n * step + 256);       // cos(2 pi n / size)
+    int32_t w = 32767;
+    if (_window_type == MPU6050_WINDOW_HANN)
+      w = (32767 - c) >> 1;
+    else if (_window_type == MPU6050_WINDOW_HAMMING)
+      w = (17694L * 32767 - 15073L * c) >> 15;
+    x = (x * w) >> 16; // one bit down so it fits 16 bits
+    _buffer[n] = x;
+    uint16_t m = x < 0 ? -x : x;
+    if (m > peak)
+      peak = m;
+  }
+  _shift = 1;
+
+  // pairs of samples become complex values, so keep each below
+  // FFT_HEADROOM / sqrt(2)
+  if (peak == 0)
+    return;
+  uint8_t up = 0;
+  while (((uint32_t)peak << (up + 1)) < FFT_HEADROOM * 181 / 256)
+    up++;
+  // a multiply, since shifting a negative value left is undefined
+  for (uint16_t n = 0; n < _size; n++)
+    _buffer[n] = clamp16((int32_t)_buffer[n] * (1 << up));
+  _shift -= up;
+}
+
+/*!
+ *  @brief  Runs an in-place radix-2 complex FFT over the buffer as
+ *          `size / 2` interleaved complex values. A stage is scaled by half
+ *          only when its input could overflow.
+ */
+void Adafruit_MPU6050_FFT::_transform(void) {
+  uint16_t m = _size / 2;
+
+  // bit reversed reordering
+  for (uint16_t i = 1, j = 0; i < m; i++) {
+    uint16_t bit = m >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j |= bit;
+    if (i < j) {
+      int16_t t = _buffer[2 * i];
+      _buffer[2 * i] = _buffer[2 * j];
+      _buffer[2 * j] = t;
+      t = _buffer[2 * i + 1];
+      _buffer[2 * i + 1] = _buffer[2 * j + 1];
+      _buffer[2 * j + 1] = t;
+    }
+  }
+
+  for (uint16_t len = 2; len <= m; len <<= 1) {
+    _fitHeadroom();
+    uint16_t half = len / 2;
+    uint16_t step = MPU6050_FFT_MAX_SIZE / len;
+    for (uint16_t j = 0; j < half; j++) {
+      int32_t wr = _sin(j * step + 256); // cos
+      int32_t wi = -_sin(j * step);      // -sin, for e^(-i theta)
+      for (uint16_t i = j; i < m; i += len) {
+        int16_t *a = &_buffer[2 * i], *b = &_buffer[2 * (i + half)];
+        int32_t tr = (wr * b[0] - wi * b[1] + 16384) >> 15;
+        int32_t ti = (wr * b[1] + wi * b[0] + 16384) >> 15;
+        b[0] = a[0] - tr;
+        b[1] = a[1] - ti;
+        a[0] += tr;
+        a[1] += ti;
+      }
+    }
+  }
+}
+
+/*!
+ *  @brief  Turns the complex FFT of the sample pairs into bins 0 to
+ *          `size / 2 - 1` of the real FFT, in place, pairing bin k with
+ *          bin `size / 2 - k`. Values are stored at half scale.
+ */
+void Adafruit_MPU6050_FFT::_split(void) {
+  uint16_t m = _size / 2;
+  uint8_t step = MPU6050_FFT_MAX_SIZE / _size;
+
+  _fitHeadroom();
+
+  // bin 0 is real; the Nyquist bin is dropped
+  _buffer[0] = ((int32_t)_buffer[0] + _buffer[1]) >> 1;
+  _buffer[1] = 0;
+
+  for (uint16_t k = 1; k <= m / 2; k++) {
+    int16_t *p = &_buffer[2 * k], *q = &_buffer[2 * (m - k)];
+    // even = Z[k] + conj(Z[m - k]), odd = -i (Z[k] - conj(Z[m - k]))
+    int32_t er = (int32_t)p[0] + q[0], ei = (int32_t)p[1] - q[1];
+    int32_t or_ = (int32_t)p[1] + q[1], oi = (int32_t)q[0] - p[0];
+    int32_t wr = _sin(k * step + 256), wi = -_sin(k * step);
+    int32_t tr = (wr * or_ - wi * oi + 16384) >> 15;
+    int32_t ti = (wr * oi + wi * or_ + 16384) >> 15;
+    // X[k] = (even + W odd) / 2 and X[m - k] = conj(even - W odd) / 2,
+    // stored at a further half scale
+    p[0] = (er + tr) >> 2;
+    p[1] = (ei + ti) >> 2;
+    q[0] = (er - tr) >> 2;
+    q[1] = -((ei - ti) >> 2);
+  }
+  _shift++;
+}
+
+/*!
+ *  @brief  Halves the buffer until every complex value is below
+ *          `FFT_HEADROOM` in magnitude, so the next butterfly stage can't
+ *          overflow
+ */
+void Adafruit_MPU6050_FFT::_fitHeadroom(void) {
+  uint32_t peak = 0;
+  for (uint16_t i = 0; i < _size; i += 2) {
+    int32_t re = _buffer[i], im = _buffer[i + 1];
+    uint32_t sq = (uint32_t)(re * re) + (uint32_t)(im * im);
+    if (sq > peak)
+      peak = sq;
+  }
+
+  uint8_t down = 0;
+  while (peak >= (uint32_t)(FFT_HEADROOM * FFT_HEADROOM)) {
+    peak >>= 2;
+    down++;
+  }
+  if (!down)
+    return;
+  for (uint16_t i = 0; i < _size; i++)
+    _buffer[i] = (_buffer[i] + (1 << (down - 1))) >> down;
+  _shift += down;
+}
+
+/*!
+ *  @brief  Reads sin(2 pi index / 1024) from the quarter wave table
+ */
+int16_t Adafruit_MPU6050_FFT::_sin(uint16_t index) {
+  uint16_t i = index & 255;
+  switch ((index >> 8) & 3) {
+  case 0:
+    return pgm_read_word(&sine_table[i]);
+  case 1:
+    return pgm_read_word(&sine_table[256 - i]);
+  case 2:
+    return -(int16_t)pgm_read_word(&sine_table[i]);
+  default:
+    return -(int16_t)pgm_read_word(&sine_table[256 - i]);
+  }
+}
@@ -0,0 +1,75 @@
+/*!
+ *  @file Adafruit_MPU6050_FFT.h
+ *
+ * 	Vibration spectrum of MPU6050 accelerometer blocks
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_FFT_H
+#define _ADAFRUIT_MPU6050_FFT_H
+
+#include <Adafruit_MPU6050.h>
+
+#define MPU6050_FFT_MAX_SIZE 1024 ///< Largest transform size supported
+
+/**
+ * @brief Windows applied before the transform
+ */
+typedef enum {
+  MPU6050_WINDOW_RECTANGULAR, ///< No window, for transients in the block
+  MPU6050_WINDOW_HANN,        ///< Low leakage, the usual choice
+  MPU6050_WINDOW_HAMMING,     ///< Narrower peaks, more distant leakage
+} mpu6050_fft_window_t;
+
+/*!
+ *    @brief  Class that collects one accelerometer axis from FIFO frames
+ *            into a caller-owned buffer and turns it into an amplitude
+ *            spectrum
+ *
+ *    The transform is a fixed point real FFT done in place in the sample
+ *    buffer, with a block exponent to keep precision, so only the buffer
+ *    of `size` 16 bit words is needed. Twiddle factors come from a sine
+ *    table in flash. After `compute` the buffer holds `size / 2` bin
+ *    magnitudes and collection starts over with the next `addFrames`.
+ */
+class Adafruit_MPU6050_FFT {
+public:
+  Adafruit_MPU6050_FFT(int16_t *buffer, uint16_t size);
+
+  bool begin(float sample_rate, float accel_scale, uint8_t axis = 2,
+             mpu6050_fft_window_t window = MPU6050_WINDOW_HANN);
+
+  bool addFrames(const mpu6050_raw_frame_t *frames, uint16_t count);
+  bool compute(void);
+
+  float getBinFrequency(uint16_t bin);
+  float getAmplitude(uint16_t bin);
+  uint8_t getPeaks(float *frequencies, float *amplitudes, uint8_t count);
+  float getBandEnergy(float low, float high);
+
+private:
+  void _window(void);
+  void _transform(void);
+  void _split(void);
+  void _fitHeadroom(void);
+  static int16_t _sin(uint16_t index);
+
+  int16_t *_buffer = NULL;
+  uint16_t _size = 0, _filled = 0;
+  uint8_t _axis = 2;
+  mpu6050_fft_window_t _window_type = MPU6050_WINDOW_HANN;
+  float _sample_rate = 1000, _accel_scale = 16384;
+  int8_t _shift = 0; // true DFT value = buffer value * 2^_shift, in LSB
+  bool _ready = false;
+};
+
+#endif
@@ -0,0 +1,71 @@
+/*!
+ *  @file Adafruit_MPU6050_Math.h
+ *
+ * 	Integer helpers shared by the MPU6050 library sources. Internal to the
+ * 	library; not part of its API.
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_MATH_H
+#define _ADAFRUIT_MPU6050_MATH_H
+
+#include "Arduino.h"
+
+/*!
+ *  @brief  Saturates a value to the int16_t range
+ *  @param  value The value to saturate
+ *  @return The value, limited to -32768 to 32767
+ */
+static inline int16_t clamp16(int32_t value) {
+  if (value > INT16_MAX)
+    return INT16_MAX;
+  if (value < INT16_MIN)
+    return INT16_MIN;
+  return value;
+}
+
+/*!
+ *  @brief  Saturates a float to the int16_t range, truncating toward zero
+ *  @param  value The value to saturate
+ *  @return The value, limited to -32768 to 32767
+ */
+static inline int16_t clamp16(float value) {
+  if (value > INT16_MAX)
+    return INT16_MAX;
+  if (value < INT16_MIN)
+    return INT16_MIN;
+  return (int16_t)value;
+}
+
+/*!
+ *  @brief  Integer square root by the digit-by-digit method, with no
+ *          multiplies or divides
+ *  @param  x The value
+ *  @return The square root of `x`, rounded down
+ */
+static inline uint32_t isqrt32(uint32_t x) {
+  uint32_t root = 0, bit = (uint32_t)1 << 30;
+  while (bit > x)
+    bit >>= 2;
+  while (bit) {
+    if (x >= root + bit) {
+      x -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+#endif
@@ -0,0 +1,179 @@
+/*!
+ *  @file Adafruit_MPU6050_MuxGroup.cpp
+ *
+ *  Groups of MPU6050s behind a TCA9548A-style I2C multiplexer
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+#include <Wire.h>
+
+#include <Adafruit_MPU6050_MuxGroup.h>
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new multiplexer group
+    @param  mux_address
+            The I2C address of the multiplexer
+    @param  wire
+            The Wire object the multiplexer is connected to
+*/
+/**************************************************************************/
+Adafruit_MPU6050_MuxGroup::Adafruit_MPU6050_MuxGroup(uint8_t mux_address,
+                                                     TwoWire *wire) {
+  _mux_address = mux_address;
+  _wire = wire;
+}
+
+/*!
+ *    @brief  Cleans up the multiplexer group. Added devices are owned by the
+ *            caller and are left alone.
+ */
+Adafruit_MPU6050_MuxGroup::~Adafruit_MPU6050_MuxGroup(void) {
+  if (_mux_dev)
+    delete _mux_dev;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the multiplexer with every channel disconnected
+    @return True if the multiplexer was found
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_MuxGroup::begin(void) {
+  if (_mux_dev) {
+    delete _mux_dev; // remove old interface
+  }
+
+  _mux_dev = new Adafruit_I2CDevice(_mux_address, _wire);
+  if (!_mux_dev->begin())
+    return false;
+
+  _switches = 0;
+  return deselect();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Initializes an MPU6050 on a multiplexer channel and adds it to
+            the group
+    @param  mpu
+            The device object. It stays usable on its own after calling
+            `selectDevice` with the returned index.
+    @param  channel
+            The multiplexer channel the device is connected to
+    @param  i2c_addr
+            The I2C address of the device on that channel
+    @param  sensorID
+            The user-defined ID to differentiate different sensors
+    @return The index of the device in the group, or -1 on failure
+*/
+/**************************************************************************/
+int8_t Adafruit_MPU6050_MuxGroup::addDevice(Adafruit_MPU6050 *mpu,
+                                            uint8_t channel, uint8_t i2c_addr,
+                                            int32_t sensorID) {
+  if (_count >= MPU6050_MUX_MAX_DEVICES || channel >= MPU6050_MUX_CHANNELS)
+    return -1;
+
+  if (!selectChannel(channel))
+    return -1;
+  if (!mpu->begin(i2c_addr, _wire, sensorID))
+    return -1;
+
+  _devices[_count] = mpu;
+  _device_channels[_count] = channel;
+  return _count++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Connects one multiplexer channel to the bus. Nothing is sent if
+            the channel is already selected.
+    @param  channel
+            The channel to select, 0 to 7
+    @return True if the channel is selected
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_MuxGroup::selectChannel(uint8_t channel) {
+  if (channel >= MPU6050_MUX_CHANNELS)
+    return false;
+  if (channel == _channel)
+    return true;
+
+  if (!_writeSelection(1 << channel)) {
+    _channel = MPU6050_MUX_NO_CHANNEL;
+    return false;
+  }
+  _channel = channel;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Selects the channel of a device so it can be used directly
+    @param  index
+            The index returned by `addDevice`
+    @return True if the device's channel is selected
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_MuxGroup::selectDevice(uint8_t index) {
+  if (index >= _count)
+    return false;
+  return selectChannel(_device_channels[index]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Disconnects every channel, for sharing the bus with other
+            multiplexers
+    @return True on successful write
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_MuxGroup::deselect(void) {
+  _channel = MPU6050_MUX_NO_CHANNEL;
+  return _writeSelection(0);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads one sample from every device in the group. All devices on
+            the selected channel are read first, then each other channel in
+            turn, so every channel is selected at most once.
+    @param  samples
+            Array of at least `deviceCount()` samples, filled by device index
+    @return The number of devices read successfully
+*/
+/**************************************************************************/
+uint8_t Adafruit_MPU6050_MuxGroup::getSamples(mpu6050_sample_t *samples) {
+  uint8_t start = _channel == MPU6050_MUX_NO_CHANNEL ? 0 : _channel;
+  uint8_t read = 0;
+
+  for (uint8_t c = 0; c < MPU6050_MUX_CHANNELS; c++) {
+    uint8_t channel = (start + c) % MPU6050_MUX_CHANNELS;
+
+    for (uint8_t i = 0; i < _count; i++) {
+      if (_device_channels[i] != channel)
+        continue;
+      if (!selectChannel(channel))
+        break;
+      if (_devices[i]->getSample(&samples[i]))
+        read++;
+    }
+  }
+  return read;
+}
+
+/*!
+ *    @brief  Writes the multiplexer's channel selection register
+ *    @param  selection
+ *            One bit per channel to connect, 0 to disconnect them all
+ *    @return True on successful write, false if `begin` was not called or
+ *            the multiplexer did not respond
+ */
+bool Adafruit_MPU6050_MuxGroup::_writeSelection(uint8_t selection) {
+  if (!_mux_dev)
+    return false;
+  _switches++;
+  return _mux_dev->write(&selection, 1);
+}
@@ -0,0 +1,71 @@
+/*!
+ *  @file Adafruit_MPU6050_MuxGroup.h
+ *
+ * 	Groups of MPU6050s behind a TCA9548A-style I2C multiplexer
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_MUXGROUP_H
+#define _ADAFRUIT_MPU6050_MUXGROUP_H
+
+#include <Adafruit_MPU6050.h>
+
+#define MPU6050_MUX_I2CADDR_DEFAULT 0x70 ///< TCA9548A default i2c address
+#define MPU6050_MUX_CHANNELS 8           ///< Downstream channels per mux
+#define MPU6050_MUX_MAX_DEVICES 16 ///< Two addresses on each of 8 channels
+#define MPU6050_MUX_NO_CHANNEL 0xFF ///< No channel, or selection unknown
+
+/*!
+ *    @brief  Class that reads a set of MPU6050s spread over the channels of
+ *            one I2C multiplexer, keeping track of the selected channel so
+ *            that each channel is only selected once per pass
+ */
+class Adafruit_MPU6050_MuxGroup {
+public:
+  Adafruit_MPU6050_MuxGroup(uint8_t mux_address = MPU6050_MUX_I2CADDR_DEFAULT,
+                            TwoWire *wire = &Wire);
+  ~Adafruit_MPU6050_MuxGroup();
+
+  bool begin(void);
+  int8_t addDevice(Adafruit_MPU6050 *mpu, uint8_t channel,
+                   uint8_t i2c_addr = MPU6050_I2CADDR_DEFAULT,
+                   int32_t sensorID = 0);
+
+  bool selectChannel(uint8_t channel);
+  bool selectDevice(uint8_t index);
+  bool deselect(void);
+
+  uint8_t getSamples(mpu6050_sample_t *samples);
+
+  /** @brief Gets the number of devices added to the group
+      @returns The device count */
+  uint8_t deviceCount(void) { return _count; }
+  /** @brief Gets the number of channel selections sent to the mux
+      @returns The mux write count since `begin` */
+  uint32_t channelSwitches(void) { return _switches; }
+
+private:
+  uint8_t _mux_address;
+  TwoWire *_wire = NULL;
+  Adafruit_I2CDevice *_mux_dev = NULL;
+
+  Adafruit_MPU6050 *_devices[MPU6050_MUX_MAX_DEVICES];
+  uint8_t _device_channels[MPU6050_MUX_MAX_DEVICES];
+  uint8_t _count = 0;
+
+  uint8_t _channel = MPU6050_MUX_NO_CHANNEL;
+  uint32_t _switches = 0;
+
+  bool _writeSelection(uint8_t selection);
+};
+
+#endif
@@ -0,0 +1,154 @@
+/*!
+ *  @file Adafruit_MPU6050_Pedometer.cpp
+ *
+ *  Step counting and activity classification for the MPU6050
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_Pedometer.h>
+#include <Adafruit_MPU6050_Math.h>
+
+#define STEP_THRESHOLD 0.1  // g either side of gravity for a step
+#define RUN_INTENSITY 0.45  // mean g away from gravity when running
+#define RUN_CADENCE 145     // steps per minute from which stepping is running
+#define REGULAR_STEPS 8     // regular steps before any are counted
+#define STEP_TOLERANCE 25   // percent an interval may differ from the average
+#define MAX_STEP_GAP 2      // seconds between steps that breaks a run
+#define MAX_STEP_RATE 4     // steps per second, faster are ignored as bounce
+#define WINDOW_SECONDS 2    // length of the intensity window
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the pedometer and clears the step count
+    @param  sample_rate
+            The rate the frames were taken at in Hz, at least 10
+    @param  accel_scale
+            The accelerometer sensitivity in LSB per g, from
+            `getAccelerometerScale`
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Pedometer::begin(uint16_t sample_rate,
+                                       float accel_scale) {
+  _sample_rate = sample_rate;
+  _threshold = STEP_THRESHOLD * accel_scale;
+  _run_intensity = RUN_INTENSITY * accel_scale;
+
+  _sample = 0;
+  _started = _armed = _stepping = false;
+  _steps = _pending = 0;
+  _window_sum = _window_count = _intensity = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Processes a batch of frames. Only the accelerometer is used.
+    @param  frames
+            The frames, such as from `readFifoFrames`, in the order taken
+    @param  count
+            The number of frames
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Pedometer::update(const mpu6050_raw_frame_t *frames,
+                                        uint16_t count) {
+  uint32_t min_interval = _sample_rate / MAX_STEP_RATE;
+  uint32_t max_interval = (uint32_t)_sample_rate * MAX_STEP_GAP;
+  uint16_t window = _sample_rate * WINDOW_SECONDS;
+
+  for (uint16_t i = 0; i < count; i++) {
+    const int16_t *a = frames[i].accel;
+    int32_t magnitude = isqrt32((uint32_t)((int32_t)a[0] * a[0]) +
+                                (uint32_t)((int32_t)a[1] * a[1]) +
+                                (uint32_t)((int32_t)a[2] * a[2]));
+    _sample++;
+
+    if (!_started) {
+      _gravity = magnitude << 4;
+      _smooth = 0;
+      _last_step = _sample;
+      _started = true;
+    }
+    _gravity += ((magnitude << 4) - _gravity) >> 4;
+    int32_t dynamic = magnitude - (_gravity >> 4);
+    _smooth += (dynamic - _smooth) >> 1;
+
+    _window_sum += dynamic < 0 ? -dynamic : dynamic;
+    if (++_window_count >= window) {
+      _intensity = _window_sum / _window_count;
+      _window_sum = _window_count = 0;
+    }
+
+    uint32_t interval = _sample - _last_step;
+    if (_stepping && interval > max_interval) {
+      _stepping = false;
+      _pending = 0;
+    }
+
+    // a step is a rise above the band followed by a fall below it
+    if (_smooth > (int32_t)_threshold) {
+      _armed = true;
+      continue;
+    }
+    if (!_armed || _smooth > -(int32_t)_threshold)
+      continue;
+    _armed = false;
+    if (interval < min_interval)
+      continue; // bounce; it takes a new rise to arm again
+    _last_step = _sample;
+
+    if (interval > max_interval || (!_stepping && _pending == 0)) {
+      _pending = 1; // first step of a new run
+      _stepping = false;
+      continue;
+    }
+    int32_t scaled = interval << 4;
+    int32_t change = scaled - _interval;
+    if (!_stepping && _pending == 1) {
+      _interval = scaled;
+    } else if ((uint32_t)(change < 0 ? -change : change) * 100 >
+               (uint32_t)_interval * STEP_TOLERANCE) {
+      _pending = 1; // off the pace, so start a new run from this step
+      _stepping = false;
+      continue;
+    } else {
+      _interval += change >> 2;
+    }
+    if (_stepping) {
+      _steps++;
+    } else if (++_pending >= REGULAR_STEPS) {
+      _steps += _pending;
+      _pending = 0;
+      _stepping = true;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the current step rate
+    @return Steps per minute, or 0 when not stepping
+*/
+/**************************************************************************/
+uint16_t Adafruit_MPU6050_Pedometer::getCadence(void) {
+  if (!_stepping || !_interval)
+    return 0;
+  return (uint32_t)_sample_rate * 60 * 16 / _interval;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Classifies the current activity from whether steps are coming
+            regularly, their cadence, and how hard the last intensity
+            window moved
+    @return The `mpu6050_activity_t` activity
+*/
+/**************************************************************************/
+mpu6050_activity_t Adafruit_MPU6050_Pedometer::getActivity(void) {
+  if (!_stepping)
+    return MPU6050_ACTIVITY_STILL;
+  if (getCadence() >= RUN_CADENCE || _intensity >= _run_intensity)
+    return MPU6050_ACTIVITY_RUN;
+  return MPU6050_ACTIVITY_WALK;
+}
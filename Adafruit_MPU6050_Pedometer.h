@@ -0,0 +1,81 @@
+/*!
+ *  @file Adafruit_MPU6050_Pedometer.h
+ *
+ * 	Step counting and activity classification for the MPU6050
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_PEDOMETER_H
+#define _ADAFRUIT_MPU6050_PEDOMETER_H
+
+#include <Adafruit_MPU6050.h>
+
+/**
+ * @brief Activities reported by `Adafruit_MPU6050_Pedometer`
+ */
+typedef enum {
+  MPU6050_ACTIVITY_STILL, ///< Not stepping
+  MPU6050_ACTIVITY_WALK,  ///< Stepping at a walking cadence and intensity
+  MPU6050_ACTIVITY_RUN,   ///< Stepping at a running cadence or intensity
+} mpu6050_activity_t;
+
+/*!
+ *    @brief  Class that counts steps and classifies activity from batches of
+ *            accelerometer frames, using integer math and no buffers
+ *
+ *    Steps are swings of the acceleration magnitude, with gravity tracked
+ *    and removed, through a hysteresis band. A swing that comes faster than
+ *    four per second is bounce, and the next step needs a new rise. Steps
+ *    are only counted once eight have come at a regular pace, so that
+ *    bumps are ignored, and a step more than 25% off the average pace ends
+ *    the run.
+ *    All timing is in samples, so batches can be drained from the FIFO
+ *    long after they were taken. A rate of 20 Hz, such as from cycle mode
+ *    with the gyro in standby, is enough.
+ */
+class Adafruit_MPU6050_Pedometer {
+public:
+  void begin(uint16_t sample_rate, float accel_scale);
+  void update(const mpu6050_raw_frame_t *frames, uint16_t count);
+
+  /** @brief Gets the number of steps counted since `begin` or `resetSteps`
+      @returns The step count */
+  uint32_t getSteps(void) { return _steps; }
+  /** @brief Sets the step count back to zero */
+  void resetSteps(void) { _steps = 0; }
+
+  uint16_t getCadence(void);
+  mpu6050_activity_t getActivity(void);
+
+private:
+  uint16_t _sample_rate = 20;
+  uint32_t _sample = 0;    // samples seen, the time base
+  uint32_t _last_step = 0; // sample of the last step
+
+  int32_t _gravity = 0; // slow average of the magnitude, 4 fractional bits
+  int32_t _smooth = 0;  // magnitude minus gravity, lightly smoothed
+  bool _started = false, _armed = false;
+
+  uint32_t _steps = 0;
+  uint8_t _pending = 0; // regular steps not yet counted
+  bool _stepping = false;
+  int32_t _interval = 0; // average step interval, 4 fractional bits
+
+  uint32_t _window_sum = 0; // sum of |magnitude - gravity| this window
+  uint16_t _window_count = 0;
+  uint16_t _intensity = 0; // mean of the last window, in LSB
+
+  uint16_t _threshold = 1638; // step hysteresis, in LSB
+  uint16_t _run_intensity = 7373;
+};
+
+#endif
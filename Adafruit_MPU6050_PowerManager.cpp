@@ -0,0 +1,154 @@
+/*!
+ *  @file Adafruit_MPU6050_PowerManager.cpp
+ *
+ *  Wake-on-motion power management for the MPU6050
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_PowerManager.h>
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new power manager
+    @param  mpu
+            The device to manage, already started with `begin`
+*/
+/**************************************************************************/
+Adafruit_MPU6050_PowerManager::Adafruit_MPU6050_PowerManager(
+    Adafruit_MPU6050 *mpu) {
+  _mpu = mpu;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the motion interrupt and starts in the active state.
+            The INT pin is latched so the host can sleep until it fires.
+            Motion is never detected with the high pass filter reset, so
+            if it is disabled it is set to 0.63 Hz; any other setting is
+            kept.
+    @param  holdoff
+            Milliseconds without motion before dropping to cycle mode
+    @param  threshold
+            Motion detection threshold, LSB = 2 mg
+    @param  rate
+            The accelerometer rate while in cycle mode
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_PowerManager::begin(uint32_t holdoff, uint8_t threshold,
+                                          mpu6050_cycle_rate_t rate) {
+  _holdoff = holdoff;
+  _rate = rate;
+
+  _mpu->setMotionDetectionThreshold(threshold);
+  _mpu->setMotionDetectionDuration(1);
+  _mpu->setInterruptPinLatch(true);
+  _mpu->setMotionInterrupt(true);
+
+  _save();
+  if (_highpass == MPU6050_HIGHPASS_DISABLE)
+    _highpass = MPU6050_HIGHPASS_0_63_HZ;
+  wake();
+  _wake_latency = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads the interrupt flags and changes state if needed. Call it
+            regularly while active, and when the INT pin fires while in
+            cycle mode.
+    @return The power state after the update
+*/
+/**************************************************************************/
+mpu6050_power_state_t Adafruit_MPU6050_PowerManager::update(void) {
+  uint32_t start = micros();
+  uint32_t now = millis();
+
+  if (!_mpu->readInterruptStatus(&_status, NULL, false))
+    return _state;
+
+  if (_status.interrupts & MPU6050_INT_MOTION) {
+    _last_motion = now;
+    if (_state == MPU6050_POWER_LOW_POWER) {
+      wake();
+      _wake_latency = micros() - start;
+    }
+  } else if (_state == MPU6050_POWER_ACTIVE && now - _last_motion >= _holdoff) {
+    sleep();
+  }
+  return _state;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Drops to accelerometer-only cycle mode. The high pass filter is
+            reset and then held, so motion is detected relative to the
+            orientation at the time of sleeping, and the clock is switched
+            off the gyro before the gyro is put in standby. The settings
+            changed here are saved for `wake`.
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_PowerManager::sleep(void) {
+  if (_state == MPU6050_POWER_ACTIVE)
+    _save();
+
+  _mpu->setHighPassFilter(MPU6050_HIGHPASS_DISABLE);
+  delay(1);
+  _mpu->setHighPassFilter(MPU6050_HIGHPASS_HOLD);
+
+  _mpu->setClock(MPU6050_INTR_8MHz);
+  _mpu->setGyroStandby(true, true, true);
+  _mpu->setCycleRate(_rate);
+  _mpu->setTemperatureStandby(true);
+  _mpu->enableSleep(false);
+  _mpu->enableCycle(true);
+
+  _state = MPU6050_POWER_LOW_POWER;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Returns to full-rate accelerometer and gyro sampling. Cycle mode
+            is left before the gyro is started, then the clock, temperature
+            sensor and high pass filter settings saved by `sleep` are
+            restored.
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_PowerManager::wake(void) {
+  _mpu->enableCycle(false);
+  _mpu->enableSleep(false);
+  _mpu->setTemperatureStandby(_temp_standby);
+  _mpu->setGyroStandby(false, false, false);
+  _mpu->setClock(_clock);
+  _mpu->setHighPassFilter(_highpass);
+
+  _last_motion = millis();
+  _state = MPU6050_POWER_ACTIVE;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Estimates the sensor's supply current in the current state,
+            from the typical figures in the datasheet
+    @return The estimated current in microamps
+*/
+/**************************************************************************/
+uint16_t Adafruit_MPU6050_PowerManager::getEstimatedCurrent(void) {
+  // accelerometer low power mode at 1.25, 5, 20 and 40 Hz
+  static const uint16_t cycle_current[] = {10, 20, 70, 140};
+
+  if (_state == MPU6050_POWER_ACTIVE)
+    return 3800;
+  return cycle_current[_rate];
+}
+
+/*!
+ *    @brief  Saves the settings `sleep` changes, so `wake` can restore them
+ */
+void Adafruit_MPU6050_PowerManager::_save(void) {
+  _highpass = _mpu->getHighPassFilter();
+  _clock = _mpu->getClock();
+  _temp_standby = _mpu->getTemperatureStandby();
+}
@@ -0,0 +1,84 @@
+/*!
+ *  @file Adafruit_MPU6050_PowerManager.h
+ *
+ * 	Wake-on-motion power management for the MPU6050
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_POWERMANAGER_H
+#define _ADAFRUIT_MPU6050_POWERMANAGER_H
+
+#include <Adafruit_MPU6050.h>
+
+/**
+ * @brief Power states managed by `Adafruit_MPU6050_PowerManager`
+ */
+typedef enum {
+  MPU6050_POWER_ACTIVE,    ///< Accelerometer and gyro at the full rate
+  MPU6050_POWER_LOW_POWER, ///< Accelerometer only, in cycle mode
+} mpu6050_power_state_t;
+
+/*!
+ *    @brief  Class that moves the MPU6050 between full-rate 6-DoF sampling
+ *            and accelerometer-only cycle mode. It drops to cycle mode after
+ *            a hold-off with no motion interrupt, and returns to full rate
+ *            on the next motion interrupt. The high pass filter, clock and
+ *            temperature sensor settings in use when it sleeps are put back
+ *            when it wakes. The gyro is always woken on all three axes.
+ */
+class Adafruit_MPU6050_PowerManager {
+public:
+  Adafruit_MPU6050_PowerManager(Adafruit_MPU6050 *mpu);
+
+  void begin(uint32_t holdoff = 5000, uint8_t threshold = 2,
+             mpu6050_cycle_rate_t rate = MPU6050_CYCLE_5_HZ);
+  mpu6050_power_state_t update(void);
+
+  void sleep(void);
+  void wake(void);
+
+  /** @brief Sets how long without motion before dropping to cycle mode
+      @param holdoff The hold-off in milliseconds */
+  void setHoldoff(uint32_t holdoff) { _holdoff = holdoff; }
+  /** @brief Gets the current power state
+      @returns The `mpu6050_power_state_t` state */
+  mpu6050_power_state_t getState(void) { return _state; }
+  /** @brief Gets the flags read by the last `update`. `update` reads and
+      clears `INT_STATUS`, so other users should take the flags from here.
+      @returns The last interrupt status */
+  mpu6050_int_status_t getLastStatus(void) { return _status; }
+  /** @brief Gets the time the last wake took, from `update` seeing the
+      motion flag to full-rate configuration being written. The gyro needs
+      about 30 ms more before its data is valid.
+      @returns The wake latency in microseconds */
+  uint32_t getWakeLatency(void) { return _wake_latency; }
+
+  uint16_t getEstimatedCurrent(void);
+
+private:
+  void _save(void);
+
+  Adafruit_MPU6050 *_mpu = NULL;
+  mpu6050_power_state_t _state = MPU6050_POWER_ACTIVE;
+  mpu6050_cycle_rate_t _rate = MPU6050_CYCLE_5_HZ;
+  mpu6050_int_status_t _status = {0, 0};
+  uint32_t _holdoff = 5000;
+  uint32_t _last_motion = 0;
+  uint32_t _wake_latency = 0;
+
+  // settings in effect while active, restored by `wake`
+  mpu6050_highpass_t _highpass = MPU6050_HIGHPASS_0_63_HZ;
+  mpu6050_clock_select_t _clock = MPU6050_PLL_GYROX;
+  bool _temp_standby = false;
+};
+
+#endif
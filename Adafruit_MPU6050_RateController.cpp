@@ -0,0 +1,165 @@
+/*!
+ *  @file Adafruit_MPU6050_RateController.cpp
+ *
+ *  Activity driven sample rate control for the MPU6050
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_RateController.h>
+
+// Rate steps, fastest first. The DLPF is always on so the gyro output rate
+// is 1 kHz, and each bandwidth is below the Nyquist frequency of its rate.
+const uint16_t Adafruit_MPU6050_RateController::_rates[MPU6050_RATE_LEVELS] = {
+    1000, 500, 200, 100, 50, 25};
+const uint8_t
+    Adafruit_MPU6050_RateController::_divisors[MPU6050_RATE_LEVELS] = {
+        0, 1, 4, 9, 19, 39};
+const mpu6050_bandwidth_t
+    Adafruit_MPU6050_RateController::_bandwidths[MPU6050_RATE_LEVELS] = {
+        MPU6050_BAND_184_HZ, MPU6050_BAND_94_HZ, MPU6050_BAND_94_HZ,
+        MPU6050_BAND_44_HZ,  MPU6050_BAND_21_HZ, MPU6050_BAND_10_HZ};
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new rate controller
+    @param  mpu
+            The device to control, already started with `begin` and with
+            its FIFO enabled
+*/
+/**************************************************************************/
+Adafruit_MPU6050_RateController::Adafruit_MPU6050_RateController(
+    Adafruit_MPU6050 *mpu) {
+  _mpu = mpu;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the thresholds and starts at the lowest rate
+    @param  motion
+            Window activity in g above which the rate goes to the maximum
+    @param  quiet
+            Window activity in g below which a window counts as quiet.
+            Should be below `motion` to give hysteresis.
+    @param  window
+            The window length in milliseconds, the same at every rate
+    @param  holdoff
+            The number of quiet windows in a row before stepping down
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_RateController::begin(float motion, float quiet,
+                                            uint16_t window, uint8_t holdoff) {
+  _motion = motion;
+  _quiet = quiet;
+  _window_ms = window;
+  _holdoff = holdoff;
+  _apply(MPU6050_RATE_LEVELS - 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Caps the rate the controller will go up to, to bound the bus
+            traffic and the processing done per second
+    @param  rate
+            The highest sample rate allowed in Hz. The slowest step is
+            always allowed.
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_RateController::setMaxSampleRate(uint16_t rate) {
+  _max_level = 0;
+  while (_max_level < MPU6050_RATE_LEVELS - 1 && _rates[_max_level] > rate)
+    _max_level++;
+  if (_level < _max_level)
+    _apply(_max_level);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Feeds frames read from the FIFO and changes the rate if a window
+            completes that calls for it. When the rate changes the FIFO is
+            reset, so frames read afterwards are all at the new rate.
+    @param  frames
+            The frames to process
+    @param  count
+            The number of frames
+    @return True if the rate changed, so the caller should pick up the new
+            `getSampleRate`
+*/
+/**************************************************************************/
+bool Adafruit_MPU6050_RateController::update(const mpu6050_raw_frame_t *frames,
+                                             uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    if (_samples == 0) {
+      for (uint8_t a = 0; a < 3; a++)
+        _origin[a] = frames[i].accel[a];
+    }
+    for (uint8_t a = 0; a < 3; a++) {
+      float d = (int32_t)frames[i].accel[a] - _origin[a];
+      _sum[a] += d;
+      _sum_sq[a] += d * d;
+    }
+    if (++_samples < _window)
+      continue;
+
+    float variance = 0;
+    for (uint8_t a = 0; a < 3; a++) {
+      float mean = _sum[a] / _samples;
+      variance += _sum_sq[a] / _samples - mean * mean;
+    }
+    _activity = sqrt(variance) / _mpu->getAccelerometerScale();
+    _startWindow();
+
+    if (_activity > _motion) {
+      _quiet_windows = 0;
+      if (_level != _max_level) {
+        _apply(_max_level);
+        return true;
+      }
+    } else if (_activity < _quiet) {
+      if (++_quiet_windows >= _holdoff &&
+          _level < MPU6050_RATE_LEVELS - 1) {
+        _apply(_level + 1);
+        return true;
+      }
+    } else {
+      _quiet_windows = 0;
+    }
+  }
+  return false;
+}
+
+/*!
+ *  @brief  Reconfigures the sensor for a rate step. The bandwidth is always
+ *          the lower of the old and new settings while the divisor changes,
+ *          so no window lets through content the new rate would alias, and
+ *          the FIFO is flushed of frames from the old rate.
+ */
+void Adafruit_MPU6050_RateController::_apply(uint8_t level) {
+  if (level > _level) {
+    _mpu->setFilterBandwidth(_bandwidths[level]);
+    _mpu->setSampleRateDivisor(_divisors[level]);
+  } else {
+    _mpu->setSampleRateDivisor(_divisors[level]);
+    _mpu->setFilterBandwidth(_bandwidths[level]);
+  }
+  // stop, clear and restart, so no frame from the old rate is left queued
+  _mpu->enableFifo(true);
+
+  _level = level;
+  _quiet_windows = 0;
+  _startWindow();
+}
+
+/*!
+ *  @brief  Clears the window accumulators and sizes the window for the
+ *          current rate
+ */
+void Adafruit_MPU6050_RateController::_startWindow(void) {
+  uint32_t samples = (uint32_t)_window_ms * _rates[_level] / 1000;
+  _window = samples < 2 ? 2 : (samples > 0xFFFF ? 0xFFFF : samples);
+  _samples = 0;
+  for (uint8_t a = 0; a < 3; a++)
+    _sum[a] = _sum_sq[a] = 0;
+}
@@ -0,0 +1,72 @@
+/*!
+ *  @file Adafruit_MPU6050_RateController.h
+ *
+ * 	Activity driven sample rate control for the MPU6050
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_RATECONTROLLER_H
+#define _ADAFRUIT_MPU6050_RATECONTROLLER_H
+
+#include <Adafruit_MPU6050.h>
+
+#define MPU6050_RATE_LEVELS 6 ///< Number of rate steps the controller uses
+
+/*!
+ *    @brief  Class that watches the accelerometer variance of FIFO frames
+ *            and moves the sample rate and DLPF bandwidth between a set of
+ *            steps: straight to the highest allowed rate on motion, and down
+ *            one step at a time after a run of quiet windows
+ */
+class Adafruit_MPU6050_RateController {
+public:
+  Adafruit_MPU6050_RateController(Adafruit_MPU6050 *mpu);
+
+  void begin(float motion = 0.05, float quiet = 0.02, uint16_t window = 250,
+             uint8_t holdoff = 4);
+  void setMaxSampleRate(uint16_t rate);
+
+  bool update(const mpu6050_raw_frame_t *frames, uint16_t count);
+
+  /** @brief Sets how many quiet windows in a row it takes to step down
+      @param holdoff The number of windows */
+  void setHoldoff(uint8_t holdoff) { _holdoff = holdoff; }
+  /** @brief Gets the sample rate currently configured
+      @returns The sample rate in Hz */
+  uint16_t getSampleRate(void) { return _rates[_level]; }
+  /** @brief Gets the accelerometer standard deviation of the last complete
+      window, summed over the three axes in quadrature
+      @returns The activity in g */
+  float getActivity(void) { return _activity; }
+
+private:
+  void _apply(uint8_t level);
+  void _startWindow(void);
+
+  static const uint16_t _rates[MPU6050_RATE_LEVELS];
+  static const uint8_t _divisors[MPU6050_RATE_LEVELS];
+  static const mpu6050_bandwidth_t _bandwidths[MPU6050_RATE_LEVELS];
+
+  Adafruit_MPU6050 *_mpu = NULL;
+  float _motion = 0.05, _quiet = 0.02;
+  float _activity = 0;
+  uint16_t _window_ms = 250;
+  uint8_t _holdoff = 4, _quiet_windows = 0;
+  uint8_t _level = 0, _max_level = 0;
+
+  // window accumulators, relative to the window's first sample
+  int16_t _origin[3] = {0, 0, 0};
+  float _sum[3] = {0, 0, 0}, _sum_sq[3] = {0, 0, 0};
+  uint16_t _window = 0, _samples = 0;
+};
+
+#endif
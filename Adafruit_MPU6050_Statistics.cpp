@@ -0,0 +1,176 @@
+/*!
+ *  @file Adafruit_MPU6050_Statistics.cpp
+ *
+ *  Streaming per-axis statistics for the MPU6050
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_Statistics.h>
+
+/**************************************************************************/
+/*!
+    @brief  Sets the mode and length and clears all results
+    @param  mode
+            `MPU6050_STATS_WINDOW` for statistics over consecutive blocks of
+            `length` samples, or `MPU6050_STATS_EXPONENTIAL` for running
+            statistics that weight recent samples most
+    @param  length
+            The window length in samples. In exponential mode the averaging
+            length, rounded down to a power of two. A window length of 0
+            accumulates until `reset`, up to 65535 samples.
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Statistics::begin(mpu6050_stats_mode_t mode,
+                                        uint16_t length) {
+  _mode = mode;
+  _length = length;
+  _shift = 0;
+  while (_shift < 15 && (2U << _shift) <= length)
+    _shift++;
+  _round = _shift ? 1L << (_shift - 1) : 0;
+  reset();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clears the running accumulators and the last completed window
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Statistics::reset(void) {
+  _clear(_live);
+  _clear(_done);
+  _samples = _done_samples = 0;
+  _fresh = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds one frame
+    @param  frame
+            The frame to add
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Statistics::update(const mpu6050_raw_frame_t *frame) {
+  update(frame, 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds a block of frames, such as from `readFifoFrames`
+    @param  frames
+            The frames to add
+    @param  count
+            The number of frames
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Statistics::update(const mpu6050_raw_frame_t *frames,
+                                         uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    if (_mode == MPU6050_STATS_WINDOW && _samples == 0xFFFF)
+      return; // an unbounded window is full, wait for reset
+    const int16_t *values[2] = {frames[i].accel, frames[i].gyro};
+    bool first = _samples == 0;
+
+    for (uint8_t a = 0; a < 6; a++) {
+      axis_t *axis = &_live[a];
+      int16_t x = values[a / 3][a % 3];
+
+      if (first) {
+        axis->origin = axis->min = axis->max = x;
+        if (_mode == MPU6050_STATS_EXPONENTIAL)
+          axis->mean = (int32_t)x * 256;
+      }
+      if (x < axis->min)
+        axis->min = x;
+      if (x > axis->max)
+        axis->max = x;
+
+      if (_mode == MPU6050_STATS_WINDOW) {
+        int32_t d = (int32_t)x - axis->origin;
+        uint32_t m = d < 0 ? -d : d;
+        axis->sum += d;
+        axis->sum_sq += m * m;
+      } else {
+        int32_t d = (int32_t)x * 256 - axis->mean;
+        uint64_t sq = (uint64_t)((int64_t)d * d);
+        axis->mean += (d + _round) >> _shift;
+        if (sq >= axis->var)
+          axis->var += (sq - axis->var) >> _shift;
+        else
+          axis->var -= (axis->var - sq) >> _shift;
+      }
+    }
+    if (_samples < 0xFFFF)
+      _samples++;
+
+    if (_mode == MPU6050_STATS_WINDOW && _samples == _length) {
+      memcpy(_done, _live, sizeof(_done));
+      _done_samples = _samples;
+      _clear(_live);
+      _samples = 0;
+      _fresh = true;
+    } else if (_mode == MPU6050_STATS_EXPONENTIAL || _length == 0) {
+      _fresh = true;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Converts the current results to floating point. Accumulation
+            carries on unaffected. In window mode this is the last completed
+            window, or the samples so far if the length is 0.
+    @param  stats
+            Where to store the results
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_Statistics::getSnapshot(mpu6050_stats_t *stats) {
+  bool window = _mode == MPU6050_STATS_WINDOW;
+  const axis_t *axes = (window && _length) ? _done : _live;
+  uint16_t n = (window && _length) ? _done_samples : _samples;
+
+  for (uint8_t a = 0; a < 6; a++) {
+    mpu6050_axis_stats_t *out = a < 3 ? &stats->accel[a] : &stats->gyro[a - 3];
+    _finish(&axes[a], n, window, out);
+  }
+  stats->samples = n;
+  _fresh = false;
+}
+
+/*!
+ *  @brief  Zeroes a set of six axis accumulators
+ */
+void Adafruit_MPU6050_Statistics::_clear(axis_t *axes) {
+  memset(axes, 0, sizeof(axis_t) * 6);
+}
+
+/*!
+ *  @brief  Turns one axis accumulator into mean, deviation and RMS. Window
+ *          sums are relative to the first sample, which keeps the variance
+ *          free of cancellation when the mean is large.
+ */
+void Adafruit_MPU6050_Statistics::_finish(const axis_t *axis, float n,
+                                          bool window,
+                                          mpu6050_axis_stats_t *stats) {
+  float mean = 0, variance = 0;
+
+  if (window && n > 0) {
+    float offset = axis->sum / n;
+    mean = axis->origin + offset;
+    variance = (float)axis->sum_sq / n - offset * offset;
+  } else if (!window) {
+    mean = axis->mean / 256.0;
+    variance = axis->var / 65536.0;
+  }
+  if (variance < 0)
+    variance = 0;
+
+  stats->mean = mean;
+  stats->std_dev = sqrt(variance);
+  stats->rms = sqrt(variance + mean * mean);
+  stats->min = axis->min;
+  stats->max = axis->max;
+}
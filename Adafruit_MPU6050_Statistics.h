@@ -0,0 +1,95 @@
+/*!
+ *  @file Adafruit_MPU6050_Statistics.h
+ *
+ * 	Streaming per-axis statistics for the MPU6050
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_STATISTICS_H
+#define _ADAFRUIT_MPU6050_STATISTICS_H
+
+#include <Adafruit_MPU6050.h>
+
+/**
+ * @brief Accumulation modes for `Adafruit_MPU6050_Statistics`
+ */
+typedef enum {
+  MPU6050_STATS_WINDOW,      ///< Exact statistics over blocks of samples
+  MPU6050_STATS_EXPONENTIAL, ///< Exponentially weighted running statistics
+} mpu6050_stats_mode_t;
+
+/*!
+ *    @brief  Statistics for one axis, in raw LSB. Use
+ *            `getAccelerometerScale` and `getGyroScale` to convert.
+ */
+typedef struct {
+  float mean;    ///< Mean
+  float std_dev; ///< Standard deviation
+  float rms;     ///< Root mean square, including the mean
+  int16_t min;   ///< Smallest sample
+  int16_t max;   ///< Largest sample
+} mpu6050_axis_stats_t;
+
+/*!
+ *    @brief  Statistics for all six axes
+ */
+typedef struct {
+  mpu6050_axis_stats_t accel[3]; ///< X, Y and Z acceleration
+  mpu6050_axis_stats_t gyro[3];  ///< X, Y and Z rotation
+  uint16_t samples;              ///< Samples the statistics cover
+} mpu6050_stats_t;
+
+/*!
+ *    @brief  Class that accumulates mean, variance, RMS and range for the
+ *            six axes of raw frames using integer updates. Results are only
+ *            converted to float when a snapshot is taken.
+ */
+class Adafruit_MPU6050_Statistics {
+public:
+  void begin(mpu6050_stats_mode_t mode = MPU6050_STATS_WINDOW,
+             uint16_t length = 1000);
+  void reset(void);
+
+  void update(const mpu6050_raw_frame_t *frame);
+  void update(const mpu6050_raw_frame_t *frames, uint16_t count);
+
+  /** @brief Checks for results not yet taken with `getSnapshot`. In window
+      mode this is a completed window, in exponential mode or with a window
+      length of 0 any new sample.
+      @returns True if there are new results */
+  bool available(void) { return _fresh; }
+  void getSnapshot(mpu6050_stats_t *stats);
+
+private:
+  typedef struct {
+    int64_t sum;     // window: sum of offsets from origin
+    uint64_t sum_sq; // window: sum of squared offsets
+    int32_t mean;    // exponential: mean in Q8
+    uint64_t var;    // exponential: variance in Q16
+    int16_t origin;  // window: first sample of the window
+    int16_t min, max;
+  } axis_t;
+
+  void _clear(axis_t *axes);
+  static void _finish(const axis_t *axis, float n, bool window,
+                      mpu6050_axis_stats_t *stats);
+
+  mpu6050_stats_mode_t _mode = MPU6050_STATS_WINDOW;
+  uint16_t _length = 1000; // window mode: samples per window
+  uint8_t _shift = 10;     // exponential mode: weight of a new sample, 2^-n
+  int32_t _round = 512;    // half of 2^_shift, so the mean does not drift
+  axis_t _live[6], _done[6];
+  uint16_t _samples = 0, _done_samples = 0;
+  bool _fresh = false;
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*!
+ *  @file Adafruit_MPU6050_TapDetector.cpp
+ *
+ *  Software tap and double tap detection for the MPU6050
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Arduino.h"
+
+#include <Adafruit_MPU6050_TapDetector.h>
+
+// the high pass corner is sample_rate / (2 pi 2^HIGHPASS_SHIFT), 10 Hz at 1 kHz
+#define HIGHPASS_SHIFT 4
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the detector with the default timings
+    @param  sample_rate
+            The rate the frames are read at in Hz. Taps last a few
+            milliseconds, so this should be several hundred Hz.
+    @param  accel_scale
+            The accelerometer sensitivity in LSB per g, from
+            `getAccelerometerScale`
+    @param  threshold
+            The high passed acceleration a tap must reach, in g
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_TapDetector::begin(float sample_rate, float accel_scale,
+                                         float threshold) {
+  _sample_rate = sample_rate;
+  _accel_scale = accel_scale;
+  setThreshold(threshold);
+  setTimings();
+  _started = false;
+  _state = IDLE;
+  _taps = 0;
+  _below = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the tap threshold
+    @param  threshold
+            The high passed acceleration a tap must reach, in g
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_TapDetector::setThreshold(float threshold) {
+  float lsb = threshold * _accel_scale;
+  _threshold = lsb > 65535 ? 65535 : lsb;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the timing windows
+    @param  duration
+            The longest a spike can stay above the threshold and still be
+            a tap, in milliseconds
+    @param  latency
+            The time after a tap during which ringing is ignored, in
+            milliseconds
+    @param  window
+            The time after the latency in which a second tap makes a
+            double tap, in milliseconds. 0 reports every tap as a single
+            tap as soon as the latency has passed.
+    @param  quiet
+            How long the signal must stay below the threshold before a tap
+            can start, in milliseconds, so vibration is not taken for taps
+*/
+/**************************************************************************/
+void Adafruit_MPU6050_TapDetector::setTimings(uint16_t duration,
+                                              uint16_t latency,
+                                              uint16_t window, uint16_t quiet) {
+  _duration = duration * _sample_rate / 1000;
+  if (_duration == 0)
+    _duration = 1;
+  _latency = latency * _sample_rate / 1000;
+  _window = window * _sample_rate / 1000;
+  _quiet = quiet * _sample_rate / 1000;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Runs a block of frames through the detector
+    @param  frames
+            The frames, such as from `readFifoFrames`
+    @param  count
+            The number of frames
+    @return The `MPU6050_TAP_SINGLE` and `MPU6050_TAP_DOUBLE` flags of any
+            taps completed in the block, or 0
+*/
+/**************************************************************************/
+uint8_t Adafruit_MPU6050_TapDetector::update(const mpu6050_raw_frame_t *frames,
+                                             uint16_t count) {
+  uint8_t events = 0;
+
+  for (uint16_t i = 0; i < count; i++) {
+    const int16_t *accel = frames[i].accel;
+
+    if (!_started) {
+      for (uint8_t a = 0; a < 3; a++)
+        _low[a] = (int32_t)accel[a] << HIGHPASS_SHIFT;
+      _started = true;
+    }
+
+    // largest high passed axis
+    uint16_t peak = 0;
+    uint8_t peak_axis = 0;
+    int32_t peak_value = 0;
+    for (uint8_t a = 0; a < 3; a++) {
+      int32_t x = (int32_t)accel[a] << HIGHPASS_SHIFT;
+      _low[a] += (x - _low[a]) >> HIGHPASS_SHIFT;
+      int32_t high = (x - _low[a]) >> HIGHPASS_SHIFT;
+      uint16_t m = high < 0 ? -high : high;
+      if (m > peak) {
+        peak = m;
+        peak_axis = a;
+        peak_value = high;
+      }
+    }
+    bool above = peak > _threshold;
+    bool settled = _below >= _quiet;
+    if (above)
+      _below = 0;
+    else if (_below < 0xFFFF)
+      _below++;
+
+    _timer++;
+    switch (_state) {
+    case IDLE:
+    case WINDOW:
+      if (above && !settled) {
+        // no quiet lead-in, so vibration or motion rather than a tap; a
+        // tap waiting for its window still happened
+        if (_taps)
+          events |= MPU6050_TAP_SINGLE;
+        _taps = 0;
+        _state = SETTLE;
+      } else if (above) {
+        if (_taps == 0) {
+          _axis = peak_axis;
+          _direction = peak_value < 0 ? -1 : 1;
+        }
+        _state = TAP;
+        _timer = 0;
+      } else if (_state == WINDOW && _timer >= _window) {
+        events |= MPU6050_TAP_SINGLE;
+        _taps = 0;
+        _state = IDLE;
+      }
+      break;
+
+    case TAP:
+      if (_timer > _duration) {
+        // too long for a tap, wait for the motion to end
+        if (_taps)
+          events |= MPU6050_TAP_SINGLE;
+        _taps = 0;
+        _state = SETTLE;
+      } else if (!above) {
+        if (++_taps == 2) {
+          events |= MPU6050_TAP_DOUBLE;
+          _taps = 0;
+        }
+        _state = LATENCY;
+        _timer = 0;
+      }
+      break;
+
+    case LATENCY:
+      if (_timer >= _latency) {
+        if (_taps && _window) {
+          _state = WINDOW;
+        } else {
+          if (_taps)
+            events |= MPU6050_TAP_SINGLE;
+          _taps = 0;
+          _state = IDLE;
+        }
+        _timer = 0;
+      }
+      break;
+
+    case SETTLE:
+      if (!above) {
+        _state = IDLE;
+      }
+      break;
+    }
+    if (_timer == 0xFFFF)
+      _timer--;
+  }
+  return events;
+}
@@ -0,0 +1,72 @@
+/*!
+ *  @file Adafruit_MPU6050_TapDetector.h
+ *
+ * 	Software tap and double tap detection for the MPU6050
+ *
+ * 	This is a library for the Adafruit MPU6050 breakout:
+ * 	https://www.adafruit.com/products/3886
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_MPU6050_TAPDETECTOR_H
+#define _ADAFRUIT_MPU6050_TAPDETECTOR_H
+
+#include <Adafruit_MPU6050.h>
+
+#define MPU6050_TAP_SINGLE 0x01 ///< A tap with no second tap in the window
+#define MPU6050_TAP_DOUBLE 0x02 ///< Two taps within the window
+
+/*!
+ *    @brief  Class that finds taps and double taps in the accelerometer
+ *            stream of raw frames
+ *
+ *    Each axis goes through an integer high pass filter. A tap is a spike
+ *    above the threshold on any axis, after a quiet time, that falls back
+ *    within the tap duration; anything else is treated as motion or
+ *    vibration and ignored. After a tap, ringing is ignored for the latency
+ *    time, then a second tap within the window makes a double tap. A single
+ *    tap is only reported once the window has passed without one, or once
+ *    motion other than a tap ends the window early. Every sample costs the
+ *    same few integer operations.
+ */
+class Adafruit_MPU6050_TapDetector {
+public:
+  void begin(float sample_rate, float accel_scale, float threshold = 1.0);
+  void setThreshold(float threshold);
+  void setTimings(uint16_t duration = 40, uint16_t latency = 80,
+                  uint16_t window = 250, uint16_t quiet = 20);
+
+  uint8_t update(const mpu6050_raw_frame_t *frames, uint16_t count);
+
+  /** @brief Gets the axis the last tap was strongest on
+      @returns 0 to 2 for X to Z */
+  uint8_t getTapAxis(void) { return _axis; }
+  /** @brief Gets the direction of the last tap's first spike on its axis
+      @returns 1 for positive, -1 for negative */
+  int8_t getTapDirection(void) { return _direction; }
+
+private:
+  typedef enum { IDLE, TAP, LATENCY, WINDOW, SETTLE } state_t;
+
+  float _sample_rate = 1000, _accel_scale = 16384;
+  int32_t _low[3] = {0, 0, 0}; // low pass of each axis, 4 fractional bits
+  bool _started = false;
+
+  state_t _state = IDLE;
+  uint8_t _taps = 0;
+  uint16_t _timer = 0;
+  uint16_t _threshold = 16384;
+  uint16_t _below = 0; // samples in a row below the threshold
+  uint16_t _duration = 40, _latency = 80, _window = 250; // in samples
+  uint16_t _quiet = 20;
+  uint8_t _axis = 2;
+  int8_t _direction = 1;
+};
+
+#endif
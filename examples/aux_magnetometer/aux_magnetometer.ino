@@ -0,0 +1,64 @@
+// Uses the MPU6050's auxiliary I2C master to read an HMC5883L magnetometer
+// connected to the XDA/XCL pins, so one read returns 9-DoF data
+
+#include <Adafruit_MPU6050.h>
+#include <Adafruit_Sensor.h>
+#include <Wire.h>
+
+#define HMC5883L_ADDR 0x1E
+
+Adafruit_MPU6050 mpu;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MPU6050 aux magnetometer test!");
+
+  // Try to initialize!
+  if (!mpu.begin()) {
+    Serial.println("Failed to find MPU6050 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("MPU6050 Found!");
+
+  mpu.setFilterBandwidth(MPU6050_BAND_44_HZ);
+  mpu.setSampleRateDivisor(9); // 100 Hz
+  mpu.enableI2CMaster(true);
+
+  // 75 Hz output, continuous measurement mode
+  if (!mpu.writeAuxRegister(HMC5883L_ADDR, 0x00, 0x18) ||
+      !mpu.writeAuxRegister(HMC5883L_ADDR, 0x02, 0x00)) {
+    Serial.println("Failed to find HMC5883L");
+    while (1) {
+      delay(10);
+    }
+  }
+  // X, Z, Y output registers
+  mpu.setAuxSlaveRead(0, HMC5883L_ADDR, 0x03, 6);
+  delay(100);
+}
+
+void loop() {
+  mpu6050_sample_t sample;
+  uint8_t mag[6];
+  if (!mpu.getExtendedSample(&sample, mag, sizeof(mag))) {
+    return;
+  }
+
+  Serial.print("AccelZ:");
+  Serial.print((int)sample.raw.accel[2]);
+  Serial.print(",GyroZ:");
+  Serial.print((int)sample.raw.gyro[2]);
+  Serial.print(",MagX:");
+  Serial.print((int)(int16_t)(mag[0] << 8 | mag[1]));
+  Serial.print(",MagY:");
+  Serial.print((int)(int16_t)(mag[4] << 8 | mag[5]));
+  Serial.print(",MagZ:");
+  Serial.println((int)(int16_t)(mag[2] << 8 | mag[3]));
+
+  delay(10);
+}
@@ -0,0 +1,72 @@
+// Filters FIFO blocks with a notch on the accelerometer and a low pass on
+// the gyro, and reports how many samples per second the filter bank can
+// process on this board
+
+#include <Adafruit_MPU6050.h>
+#include <Adafruit_MPU6050_Biquad.h>
+#include <Adafruit_Sensor.h>
+#include <Wire.h>
+
+#define SAMPLE_RATE 1000
+#define BLOCK_FRAMES 32
+
+Adafruit_MPU6050 mpu;
+Adafruit_MPU6050_Biquad filter;
+
+mpu6050_raw_frame_t block[BLOCK_FRAMES];
+uint32_t filter_time = 0, filtered = 0;
+uint16_t overflows = 0;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MPU6050 biquad filter test!");
+
+  // Try to initialize!
+  if (!mpu.begin()) {
+    Serial.println("Failed to find MPU6050 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("MPU6050 Found!");
+
+  // remove 50 Hz vibration from the accelerometer, smooth the gyro
+  filter.addSection(MPU6050_FILTER_ACCEL, MPU6050_BIQUAD_NOTCH, 50,
+                    SAMPLE_RATE, 5);
+  filter.addSection(MPU6050_FILTER_GYRO, MPU6050_BIQUAD_LOWPASS, 20,
+                    SAMPLE_RATE);
+
+  mpu.setFilterBandwidth(MPU6050_BAND_184_HZ);
+  mpu.setSampleRateDivisor(0);
+  mpu.enableFifo(true);
+}
+
+void loop() {
+  uint16_t count = mpu.readFifoFrames(block, BLOCK_FRAMES);
+  if (!count) {
+    return;
+  }
+
+  if (mpu.getFifoOverflows() != overflows) {
+    // samples were lost, so the filter history no longer matches
+    overflows = mpu.getFifoOverflows();
+    filter.reset();
+  }
+
+  uint32_t start = micros();
+  filter.process(block, count);
+  filter_time += micros() - start;
+  filtered += count;
+
+  if (filtered >= SAMPLE_RATE) {
+    Serial.print("Filtered accel Z: ");
+    Serial.print(block[count - 1].accel[2]);
+    Serial.print(", filter throughput: ");
+    Serial.print((float)filtered * 1000000 / filter_time);
+    Serial.println(" frames/s");
+    filter_time = filtered = 0;
+  }
+}
@@ -0,0 +1,15 @@
+// DMP firmware for the dmp_quaternion example
+//
+// The firmware image is not part of this library. Replace the placeholder
+// below with a MotionApps 2.0 image, such as the dmpMemory array from
+// i2cdevlib's MPU6050_6Axis_MotionApps20.h, and set DMP_FIRMWARE_SIZE to
+// its length in bytes. The image must stay in flash with PROGMEM.
+
+#ifndef DMP_FIRMWARE_H
+#define DMP_FIRMWARE_H
+
+#define DMP_FIRMWARE_SIZE 0
+
+const uint8_t dmp_firmware[] PROGMEM = {0x00};
+
+#endif
@@ -0,0 +1,103 @@
+// Runs sensor fusion on the MPU6050's own DMP and prints the orientation
+// from the quaternions it writes to the FIFO. Needs a MotionApps 2.0
+// firmware image in dmp_firmware.h.
+
+#include <Adafruit_MPU6050.h>
+#include <Adafruit_Sensor.h>
+#include <Wire.h>
+
+#include "dmp_firmware.h"
+
+#define MAX_PACKETS 4
+
+Adafruit_MPU6050 mpu;
+
+mpu6050_dmp_packet_t packets[MAX_PACKETS];
+uint16_t overflows = 0;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MPU6050 DMP quaternion test!");
+
+  if (DMP_FIRMWARE_SIZE == 0) {
+    Serial.println("Add a MotionApps 2.0 image to dmp_firmware.h");
+    while (1) {
+      delay(10);
+    }
+  }
+
+  // Try to initialize!
+  if (!mpu.begin()) {
+    Serial.println("Failed to find MPU6050 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("MPU6050 Found!");
+
+  // the DMP's fusion expects the 2000 deg/s and 2 g ranges
+  mpu.setGyroRange(MPU6050_RANGE_2000_DEG);
+  mpu.setAccelerometerRange(MPU6050_RANGE_2_G);
+
+  if (!mpu.loadDmpFirmware(dmp_firmware, DMP_FIRMWARE_SIZE)) {
+    Serial.println("Failed to load the DMP firmware");
+    while (1) {
+      delay(10);
+    }
+  }
+  // packets at 200 Hz / (1 + 3) = 50 Hz
+  mpu.setDmpOutputRate(3);
+  mpu.enableDmp(true);
+}
+
+void loop() {
+  uint16_t count = mpu.readDmpPackets(packets, MAX_PACKETS);
+  if (mpu.getFifoOverflows() != overflows) {
+    // the FIFO was read too slowly, and the DMP has been restarted
+    overflows = mpu.getFifoOverflows();
+    Serial.println("FIFO overflowed, packets were lost");
+    return;
+  }
+  if (!count) {
+    return;
+  }
+
+  // the newest packet; quaternions have 30 fractional bits
+  const mpu6050_dmp_packet_t *packet = &packets[count - 1];
+  float w = packet->quat[0] / 1073741824.0;
+  float x = packet->quat[1] / 1073741824.0;
+  float y = packet->quat[2] / 1073741824.0;
+  float z = packet->quat[3] / 1073741824.0;
+
+  float roll = atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y));
+  float sin_pitch = 2 * (w * y - z * x);
+  if (sin_pitch > 1) {
+    sin_pitch = 1;
+  } else if (sin_pitch < -1) {
+    sin_pitch = -1;
+  }
+  float pitch = asin(sin_pitch);
+  float yaw = atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z));
+  roll *= RAD_TO_DEG;
+  pitch *= RAD_TO_DEG;
+  yaw *= RAD_TO_DEG;
+
+  Serial.print("Quaternion: ");
+  Serial.print(w, 4);
+  Serial.print(", ");
+  Serial.print(x, 4);
+  Serial.print(", ");
+  Serial.print(y, 4);
+  Serial.print(", ");
+  Serial.print(z, 4);
+  Serial.print("  Roll: ");
+  Serial.print(roll);
+  Serial.print(", Pitch: ");
+  Serial.print(pitch);
+  Serial.print(", Yaw: ");
+  Serial.print(yaw);
+  Serial.println(" deg");
+}
@@ -0,0 +1,52 @@
+// Reads blocks of samples from the MPU6050 FIFO while the previous
+// block is being processed
+
+#include <Adafruit_MPU6050.h>
+#include <Adafruit_Sensor.h>
+#include <Wire.h>
+
+#define BLOCK_FRAMES 16
+
+Adafruit_MPU6050 mpu;
+
+mpu6050_raw_frame_t block_a[BLOCK_FRAMES], block_b[BLOCK_FRAMES];
+Adafruit_MPU6050_BlockReader reader(&mpu, block_a, block_b, BLOCK_FRAMES);
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MPU6050 FIFO block test!");
+
+  // Try to initialize!
+  if (!mpu.begin()) {
+    Serial.println("Failed to find MPU6050 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("MPU6050 Found!");
+
+  // 1 kHz base rate with the filter enabled, divided down to 100 Hz
+  mpu.setFilterBandwidth(MPU6050_BAND_44_HZ);
+  mpu.setSampleRateDivisor(9);
+  mpu.enableFifo(true);
+}
+
+void loop() {
+  if (!reader.update()) {
+    return;
+  }
+
+  // the next block keeps filling in the FIFO while this one is used
+  const mpu6050_raw_frame_t *block = reader.getBlock();
+  int32_t sum_z = 0;
+  for (uint16_t i = 0; i < reader.blockFrames(); i++) {
+    sum_z += block[i].accel[2];
+  }
+  reader.releaseBlock();
+
+  Serial.print("Mean raw accel Z: ");
+  Serial.println((int)(sum_z / BLOCK_FRAMES));
+}
@@ -0,0 +1,42 @@
+#include <Adafruit_MPU6050.h>
+#include <Adafruit_Sensor.h>
+#include <Wire.h>
+
+Adafruit_MPU6050 mpu;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MPU6050 free-fall test!");
+
+  // Try to initialize!
+  if (!mpu.begin()) {
+    Serial.println("Failed to find MPU6050 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("MPU6050 Found!");
+
+  // setup free-fall detection: every axis under ~0.3g for 30 ms
+  mpu.setFreefallDetectionThreshold(150);
+  mpu.setFreefallDetectionDuration(30);
+  mpu.setFreefallDetectionDecrement(1);
+  mpu.setInterruptPinLatch(true); // Keep it latched until status is read
+  mpu.setInterruptPinPolarity(true);
+  mpu.setFreefallInterrupt(true);
+
+  Serial.println("");
+  delay(100);
+}
+
+void loop() {
+  // with the INT pin wired up, the host could sleep until it goes low
+  if (mpu.getFreefallInterruptStatus()) {
+    Serial.println("Free fall detected!");
+  }
+
+  delay(10);
+}
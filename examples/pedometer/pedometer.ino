@@ -0,0 +1,60 @@
+// Counts steps with the gyro in standby and the accelerometer in cycle
+// mode, waking every few seconds to drain the batch queued in the FIFO
+
+#include <Adafruit_MPU6050.h>
+#include <Adafruit_MPU6050_Pedometer.h>
+#include <Adafruit_Sensor.h>
+#include <Wire.h>
+
+#define BLOCK_FRAMES 16
+
+Adafruit_MPU6050 mpu;
+Adafruit_MPU6050_Pedometer pedometer;
+
+mpu6050_raw_frame_t block[BLOCK_FRAMES];
+const char *activities[] = {"still", "walking", "running"};
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MPU6050 pedometer test!");
+
+  // Try to initialize!
+  if (!mpu.begin()) {
+    Serial.println("Failed to find MPU6050 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("MPU6050 Found!");
+
+  pedometer.begin(20, mpu.getAccelerometerScale());
+
+  // the gyro clock can't be used with the gyro in standby
+  mpu.setClock(MPU6050_INTR_8MHz);
+  mpu.setGyroStandby(true, true, true);
+  mpu.setCycleRate(MPU6050_CYCLE_20_HZ);
+  mpu.enableSleep(false);
+  mpu.enableCycle(true);
+  mpu.enableFifo(true);
+}
+
+void loop() {
+  // the FIFO holds 73 frames, a little over 3.5 s at 20 Hz. A real
+  // wearable would put the host to sleep here instead of waiting.
+  delay(3000);
+
+  uint16_t count;
+  while ((count = mpu.readFifoFrames(block, BLOCK_FRAMES)) > 0) {
+    pedometer.update(block, count);
+  }
+
+  Serial.print("Steps: ");
+  Serial.print(pedometer.getSteps());
+  Serial.print(", cadence: ");
+  Serial.print(pedometer.getCadence());
+  Serial.print(" steps/min, ");
+  Serial.println(activities[pedometer.getActivity()]);
+}
@@ -0,0 +1,74 @@
+// Collects Z axis acceleration from the FIFO and prints the strongest
+// vibration frequencies and the RMS vibration in a few bands
+
+#include <Adafruit_MPU6050.h>
+#include <Adafruit_MPU6050_FFT.h>
+#include <Adafruit_Sensor.h>
+#include <Wire.h>
+
+#define SAMPLE_RATE 1000
+#define FFT_SIZE 512
+#define BLOCK_FRAMES 16
+
+Adafruit_MPU6050 mpu;
+
+int16_t spectrum[FFT_SIZE];
+Adafruit_MPU6050_FFT fft(spectrum, FFT_SIZE);
+mpu6050_raw_frame_t block[BLOCK_FRAMES];
+uint16_t overflows = 0;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MPU6050 vibration spectrum test!");
+
+  // Try to initialize!
+  if (!mpu.begin()) {
+    Serial.println("Failed to find MPU6050 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("MPU6050 Found!");
+
+  mpu.setFilterBandwidth(MPU6050_BAND_184_HZ);
+  mpu.setSampleRateDivisor(0);
+  fft.begin(SAMPLE_RATE, mpu.getAccelerometerScale());
+  mpu.enableFifo(true);
+}
+
+void loop() {
+  uint16_t count = mpu.readFifoFrames(block, BLOCK_FRAMES);
+  if (mpu.getFifoOverflows() != overflows) {
+    // samples were lost, so the partly collected block is not usable
+    overflows = mpu.getFifoOverflows();
+    fft.begin(SAMPLE_RATE, mpu.getAccelerometerScale());
+    return;
+  }
+  if (!count || !fft.addFrames(block, count)) {
+    return;
+  }
+  fft.compute();
+
+  float frequencies[3], amplitudes[3];
+  uint8_t peaks = fft.getPeaks(frequencies, amplitudes, 3);
+  for (uint8_t i = 0; i < peaks; i++) {
+    Serial.print(frequencies[i]);
+    Serial.print(" Hz: ");
+    Serial.print(amplitudes[i], 4);
+    Serial.print(" g  ");
+  }
+  Serial.println();
+
+  Serial.print("RMS 10-100 Hz: ");
+  Serial.print(sqrt(fft.getBandEnergy(10, 100)), 4);
+  Serial.print(" g, 100-500 Hz: ");
+  Serial.print(sqrt(fft.getBandEnergy(100, 500)), 4);
+  Serial.println(" g");
+
+  // the FIFO holds 73 ms at 1 kHz, less than printing takes, so start the
+  // next block from fresh samples
+  mpu.resetFifo();
+}
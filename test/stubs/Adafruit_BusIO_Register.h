@@ -0,0 +1,86 @@
+/*!
+ *  @file Adafruit_BusIO_Register.h
+ *
+ *  Register access on top of the stub I2C device, behaving as BusIO does:
+ *  the register address is written, then the data read or written.
+ */
+
+#ifndef _TEST_STUBS_ADAFRUIT_BUSIO_REGISTER_H
+#define _TEST_STUBS_ADAFRUIT_BUSIO_REGISTER_H
+
+#include <Adafruit_I2CDevice.h>
+
+class Adafruit_BusIO_Register {
+public:
+  Adafruit_BusIO_Register(Adafruit_I2CDevice *device, uint16_t reg_addr,
+                          uint8_t width = 1, uint8_t byteorder = LSBFIRST,
+                          uint8_t address_width = 1)
+      : _device(device), _address((uint8_t)reg_addr), _width(width),
+        _byteorder(byteorder) {
+    (void)address_width;
+  }
+  bool read(uint8_t *buffer, uint8_t len) {
+    return _device->write_then_read(&_address, 1, buffer, len);
+  }
+  bool read(uint8_t *value) { return read(value, 1); }
+  bool read(uint16_t *value) {
+    uint8_t buffer[2];
+    if (!read(buffer, 2))
+      return false;
+    *value = _byteorder == LSBFIRST ? buffer[1] << 8 | buffer[0]
+                                    : buffer[0] << 8 | buffer[1];
+    return true;
+  }
+  uint32_t read(void) {
+    uint8_t buffer[4];
+    if (!read(buffer, _width))
+      return (uint32_t)-1;
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < _width; i++) {
+      value <<= 8;
+      value |= _byteorder == LSBFIRST ? buffer[_width - 1 - i] : buffer[i];
+    }
+    return value;
+  }
+  bool write(uint8_t *buffer, uint8_t len) {
+    return _device->write(buffer, len, true, &_address, 1);
+  }
+  bool write(uint32_t value, uint8_t numbytes = 0) {
+    uint8_t buffer[4];
+    if (numbytes == 0)
+      numbytes = _width;
+    for (uint8_t i = 0; i < numbytes; i++) {
+      buffer[_byteorder == LSBFIRST ? i : numbytes - 1 - i] = value & 0xFF;
+      value >>= 8;
+    }
+    return write(buffer, numbytes);
+  }
+  uint8_t width(void) { return _width; }
+
+private:
+  Adafruit_I2CDevice *_device;
+  uint8_t _address, _width, _byteorder;
+};
+
+class Adafruit_BusIO_RegisterBits {
+public:
+  Adafruit_BusIO_RegisterBits(Adafruit_BusIO_Register *reg, uint8_t bits,
+                              uint8_t shift)
+      : _register(reg), _bits(bits), _shift(shift) {}
+  uint32_t read(void) {
+    return (_register->read() >> _shift) & ((1UL << _bits) - 1);
+  }
+  bool write(uint32_t value) {
+    uint32_t mask = (1UL << _bits) - 1;
+    uint32_t reg = _register->read();
+    reg &= ~(mask << _shift);
+    reg |= (value & mask) << _shift;
+    return _register->write(reg, _register->width());
+  }
+
+private:
+  Adafruit_BusIO_Register *_register;
+  uint8_t _bits, _shift;
+};
+
+#endif
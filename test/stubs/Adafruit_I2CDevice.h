@@ -0,0 +1,57 @@
+/*!
+ *  @file Adafruit_I2CDevice.h
+ *
+ *  I2C device for the host tests. Transfers go to the simulated device
+ *  attached at the same address, and fail if there is none.
+ */
+
+#ifndef _TEST_STUBS_ADAFRUIT_I2CDEVICE_H
+#define _TEST_STUBS_ADAFRUIT_I2CDEVICE_H
+
+#include "sim_i2c.h"
+
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire)
+      : _addr(addr), _wire(theWire) {}
+  bool begin(bool addr_detect = true) {
+    return !addr_detect || detected();
+  }
+  bool detected(void) {
+    sim_transfer(_wire, 1);
+    return sim_find(_wire, _addr) != NULL;
+  }
+  uint8_t address(void) { return _addr; }
+  bool read(uint8_t *buffer, size_t len, bool stop = true) {
+    (void)stop;
+    sim_transfer(_wire, 1 + len);
+    SimI2CTarget *target = sim_find(_wire, _addr);
+    return target && target->read(buffer, len);
+  }
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0) {
+    (void)stop;
+    uint8_t data[64];
+    if (prefix_len + len > sizeof(data))
+      return false;
+    memcpy(data, prefix_buffer, prefix_len);
+    memcpy(data + prefix_len, buffer, len);
+    sim_transfer(_wire, 1 + prefix_len + len);
+    SimI2CTarget *target = sim_find(_wire, _addr);
+    return target && target->write(data, prefix_len + len);
+  }
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false) {
+    (void)stop;
+    return write(write_buffer, write_len, false) &&
+           read(read_buffer, read_len);
+  }
+  size_t maxBufferSize(void) { return 32; }
+
+private:
+  uint8_t _addr;
+  TwoWire *_wire;
+};
+
+#endif
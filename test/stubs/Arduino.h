@@ -0,0 +1,36 @@
+/*!
+ *  @file Arduino.h
+ *
+ *  Minimal Arduino core for building the library's host tests. Time only
+ *  moves when `delay` is called or a simulated I2C transfer takes place.
+ */
+
+#ifndef _TEST_STUBS_ARDUINO_H
+#define _TEST_STUBS_ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define PROGMEM
+#define pgm_read_byte(a) (*(const uint8_t *)(a))
+#define pgm_read_word(a) (*(const uint16_t *)(a))
+#define pgm_read_dword(a) (*(const uint32_t *)(a))
+#define pgm_read_float(a) (*(const float *)(a))
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+
+#endif
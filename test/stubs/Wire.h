@@ -0,0 +1,26 @@
+/*!
+ *  @file Wire.h
+ *
+ *  TwoWire for the host tests. Transfers go to the devices attached with
+ *  `sim_attach` and take as long as they would at the set clock.
+ */
+
+#ifndef _TEST_STUBS_WIRE_H
+#define _TEST_STUBS_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+  void begin(void) {}
+  /*!  @brief Sets the bus clock transfer times are worked out from
+   *   @param frequency The clock in Hz */
+  void setClock(uint32_t frequency) { clock = frequency; }
+
+  uint32_t clock = 100000; ///< Bus clock in Hz
+  bool realtime = false;   ///< Also sleep for each transfer, for threads
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,58 @@
+/*!
+ *  @file sim_i2c.h
+ *
+ *  Simulated I2C devices for the host tests. A device attached to a bus,
+ *  optionally behind a multiplexer channel, answers the transfers that the
+ *  stub `Adafruit_I2CDevice` makes to its address.
+ */
+
+#ifndef _TEST_STUBS_SIM_I2C_H
+#define _TEST_STUBS_SIM_I2C_H
+
+#include <Wire.h>
+
+/*!
+ *    @brief  A device on the simulated bus. Each call is one transaction.
+ */
+class SimI2CTarget {
+public:
+  virtual ~SimI2CTarget() {}
+  /*!  @brief Handles a write transaction
+   *   @param data The bytes written
+   *   @param len The number of bytes
+   *   @returns False to NACK */
+  virtual bool write(const uint8_t *data, size_t len) = 0;
+  /*!  @brief Handles a read transaction
+   *   @param data Filled with the bytes read
+   *   @param len The number of bytes
+   *   @returns False to NACK */
+  virtual bool read(uint8_t *data, size_t len) = 0;
+};
+
+/*!
+ *    @brief  A TCA9548A: one control byte, one bit per downstream channel
+ */
+class SimTCA9548A : public SimI2CTarget {
+public:
+  bool write(const uint8_t *data, size_t len) {
+    if (len)
+      selection = data[len - 1];
+    writes++;
+    return true;
+  }
+  bool read(uint8_t *data, size_t len) {
+    memset(data, selection, len);
+    return true;
+  }
+
+  uint8_t selection = 0; ///< Channels connected to the upstream bus
+  uint32_t writes = 0;   ///< Control register writes received
+};
+
+void sim_attach(TwoWire *wire, uint8_t address, SimI2CTarget *target,
+                SimTCA9548A *mux = NULL, uint8_t channel = 0);
+void sim_detach_all(void);
+SimI2CTarget *sim_find(TwoWire *wire, uint8_t address);
+void sim_transfer(TwoWire *wire, size_t bytes);
+
+#endif
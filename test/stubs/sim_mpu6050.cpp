@@ -0,0 +1,195 @@
+/*!
+ *  @file sim_mpu6050.cpp
+ *
+ *  Simulated MPU6050 for the host tests
+ */
+
+#include <Adafruit_MPU6050.h>
+
+#include "sim_mpu6050.h"
+
+/*!
+ *    @brief  Sets every register to its power-on value and empties the FIFO
+ */
+void SimMPU6050::powerOn(void) {
+  memset(_regs, 0, sizeof(_regs));
+  _regs[MPU6050_PWR_MGMT_1] = 0x40;
+  _regs[MPU6050_WHO_AM_I] = MPU6050_DEVICE_ID;
+  _fifo_count = _fifo_start = 0;
+  _next_sample = micros();
+}
+
+/*!
+ *    @brief  Gets the rate samples are taken at, from SMPLRT_DIV and the
+ *            DLPF setting
+ *    @returns Samples per second
+ */
+uint32_t SimMPU6050::sampleRate(void) {
+  uint8_t dlpf = _regs[MPU6050_CONFIG] & 0x07;
+  uint32_t gyro_rate = (dlpf == 0 || dlpf == 7) ? 8000 : 1000;
+  return gyro_rate / (1 + _regs[MPU6050_SMPLRT_DIV]);
+}
+
+/*!
+ *    @brief  Builds the 14 data register bytes from the current readings,
+ *            the set ranges and the gyro user offsets
+ *    @param  data Filled with accel, temperature and gyro, big-endian
+ */
+void SimMPU6050::frame(uint8_t data[14]) {
+  float accel_lsb = 16384 >> ((_regs[MPU6050_ACCEL_CONFIG] >> 3) & 3);
+  float gyro_lsb = 131.0 / (1 << ((_regs[MPU6050_GYRO_CONFIG] >> 3) & 3));
+  int32_t values[7];
+  for (uint8_t i = 0; i < 3; i++) {
+    const uint8_t *offset = &_regs[MPU6050_XG_OFFS_USRH + 2 * i];
+    int16_t user = (int16_t)(offset[0] << 8 | offset[1]);
+    // user offsets are in +/- 1000 degree/s LSBs whatever the range
+    values[i] = lround(accel[i] * accel_lsb);
+    values[4 + i] = lround(gyro[i] * gyro_lsb + user * gyro_lsb / 32.8);
+  }
+  values[3] = lround((temperature - 36.53) * 340);
+  for (uint8_t i = 0; i < 7; i++) {
+    int32_t v = values[i] > 32767 ? 32767 : values[i] < -32768 ? -32768
+                                                                 : values[i];
+    data[2 * i] = (uint16_t)v >> 8;
+    data[2 * i + 1] = v & 0xFF;
+  }
+}
+
+/*!
+ *    @brief  Takes every sample due by now, queueing them in the FIFO if it
+ *            is running. When full, the oldest bytes are overwritten.
+ */
+void SimMPU6050::_advance(void) {
+  unsigned long now = micros();
+  uint32_t period = 1000000 / sampleRate();
+  bool fifo = (_regs[MPU6050_USER_CTRL] & 0x40) && _regs[MPU6050_FIFO_EN];
+  if (!fifo && (long)(now - _next_sample) > 0) {
+    _next_sample = now; // nothing to queue, so skip ahead
+    return;
+  }
+
+  while ((long)(now - _next_sample) >= 0) {
+    _next_sample += period;
+    if (on_sample)
+      on_sample(this, on_sample_arg);
+
+    uint8_t data[14];
+    frame(data);
+    // FIFO_EN bits TEMP, XG, YG, ZG and ACCEL pick register ranges, and
+    // queued bytes are in register order
+    uint8_t en = _regs[MPU6050_FIFO_EN];
+    const struct {
+      uint8_t bit, first, count;
+    } ranges[] = {{3, 0, 6}, {7, 6, 2}, {6, 8, 2}, {5, 10, 2}, {4, 12, 2}};
+    for (uint8_t r = 0; r < 5; r++) {
+      if (!(en & (1 << ranges[r].bit)))
+        continue;
+      for (uint8_t b = 0; b < ranges[r].count; b++) {
+        if (_fifo_count == sizeof(_fifo)) {
+          _fifo_start = (_fifo_start + 1) % sizeof(_fifo);
+          _fifo_count--;
+        }
+        _fifo[(_fifo_start + _fifo_count++) % sizeof(_fifo)] =
+            data[ranges[r].first + b];
+      }
+    }
+  }
+}
+
+/*!
+ *    @brief  Handles a write: the register pointer, then data written to
+ *            consecutive registers
+ *    @param  data The bytes written
+ *    @param  len The number of bytes
+ *    @returns True
+ */
+bool SimMPU6050::write(const uint8_t *data, size_t len) {
+  _advance();
+  if (len == 0)
+    return true;
+  _pointer = data[0] & 0x7F;
+  for (size_t i = 1; i < len; i++)
+    _writeRegister(_pointer++ & 0x7F, data[i]);
+  return true;
+}
+
+/*!
+ *    @brief  Handles a read from the register pointer on. FIFO_R_W does
+ *            not advance the pointer, so a burst drains the FIFO.
+ *    @param  data Filled with the register values
+ *    @param  len The number of bytes
+ *    @returns True
+ */
+bool SimMPU6050::read(uint8_t *data, size_t len) {
+  _advance();
+  if (_pointer <= MPU6050_ACCEL_OUT + 13 &&
+      _pointer + len > MPU6050_ACCEL_OUT) {
+    data_reads++;
+    last_read = micros();
+  }
+  for (size_t i = 0; i < len; i++) {
+    data[i] = _readRegister(_pointer);
+    if (_pointer != MPU6050_FIFO_R_W)
+      _pointer = (_pointer + 1) & 0x7F;
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Reads one register
+ *    @param  reg The register address
+ *    @returns Its value
+ */
+uint8_t SimMPU6050::_readRegister(uint8_t reg) {
+  if (reg >= MPU6050_ACCEL_OUT && reg < MPU6050_ACCEL_OUT + 14) {
+    uint8_t data[14];
+    frame(data);
+    return data[reg - MPU6050_ACCEL_OUT];
+  }
+  switch (reg) {
+  case MPU6050_INT_STATUS:
+    return 0x01; // data ready
+  case MPU6050_FIFO_COUNT_H:
+    return _fifo_count >> 8;
+  case MPU6050_FIFO_COUNT_H + 1:
+    return _fifo_count & 0xFF;
+  case MPU6050_FIFO_R_W: {
+    if (_fifo_count == 0)
+      return 0xFF;
+    uint8_t value = _fifo[_fifo_start];
+    _fifo_start = (_fifo_start + 1) % sizeof(_fifo);
+    _fifo_count--;
+    return value;
+  }
+  default:
+    return _regs[reg];
+  }
+}
+
+/*!
+ *    @brief  Writes one register, acting on the self-clearing reset bits
+ *    @param  reg The register address
+ *    @param  value The value written
+ */
+void SimMPU6050::_writeRegister(uint8_t reg, uint8_t value) {
+  switch (reg) {
+  case MPU6050_PWR_MGMT_1:
+    if (value & 0x80) {
+      powerOn();
+      return;
+    }
+    break;
+  case MPU6050_USER_CTRL:
+    // the FIFO only resets while it is stopped
+    if ((value & 0x04) && !(value & 0x40))
+      _fifo_count = _fifo_start = 0;
+    value &= ~0x07;
+    break;
+  case MPU6050_SIGNAL_PATH_RESET:
+  case MPU6050_WHO_AM_I:
+  case MPU6050_FIFO_COUNT_H:
+  case MPU6050_FIFO_COUNT_H + 1:
+    return;
+  }
+  _regs[reg] = value;
+}
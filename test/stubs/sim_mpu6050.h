@@ -0,0 +1,53 @@
+/*!
+ *  @file sim_mpu6050.h
+ *
+ *  Simulated MPU6050 for the host tests. It has the register file, the
+ *  gyro user offsets and a FIFO filled at the configured sample rate as
+ *  simulated time passes. Readings are set in physical units.
+ */
+
+#ifndef _TEST_STUBS_SIM_MPU6050_H
+#define _TEST_STUBS_SIM_MPU6050_H
+
+#include "sim_i2c.h"
+
+/*!
+ *    @brief  A simulated MPU6050
+ */
+class SimMPU6050 : public SimI2CTarget {
+public:
+  SimMPU6050(void) { powerOn(); }
+
+  void powerOn(void);
+  bool write(const uint8_t *data, size_t len);
+  bool read(uint8_t *data, size_t len);
+
+  uint32_t sampleRate(void);
+  void frame(uint8_t data[14]);
+
+  float accel[3] = {0, 0, 1}; ///< Acceleration in g
+  float gyro[3] = {0, 0, 0};  ///< Rotation in degree/s, including any bias
+  float temperature = 25;     ///< Die temperature in C
+
+  /*!  @brief Called for every sample taken, to vary the readings
+   *   @param sim The device
+   *   @param arg The argument given in `on_sample_arg` */
+  void (*on_sample)(SimMPU6050 *sim, void *arg) = NULL;
+  void *on_sample_arg = NULL; ///< Passed to `on_sample`
+
+  uint32_t data_reads = 0;      ///< Bursts that read the data registers
+  unsigned long last_read = 0; ///< `micros` of the last data register read
+
+private:
+  uint8_t _regs[128];
+  uint8_t _pointer = 0;
+  uint8_t _fifo[1024];
+  uint16_t _fifo_start = 0, _fifo_count = 0;
+  unsigned long _next_sample = 0;
+
+  void _advance(void);
+  uint8_t _readRegister(uint8_t reg);
+  void _writeRegister(uint8_t reg, uint8_t value);
+};
+
+#endif
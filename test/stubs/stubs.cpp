@@ -0,0 +1,86 @@
+/*!
+ *  @file stubs.cpp
+ *
+ *  Definitions behind the host test stubs: the clock and the simulated bus
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "sim_i2c.h"
+
+TwoWire Wire;
+
+static std::atomic<unsigned long> now_us(0);
+
+unsigned long millis(void) { return now_us / 1000; }
+
+unsigned long micros(void) { return now_us; }
+
+void delay(unsigned long ms) { now_us += ms * 1000; }
+
+typedef struct {
+  TwoWire *wire;
+  uint8_t address;
+  SimI2CTarget *target;
+  SimTCA9548A *mux;
+  uint8_t channel;
+} attachment_t;
+
+static attachment_t attached[32];
+static uint8_t attached_count = 0;
+
+/*!
+ *    @brief  Puts a simulated device on a bus
+ *    @param  wire The bus
+ *    @param  address The 7-bit address it answers to
+ *    @param  target The device
+ *    @param  mux The multiplexer it sits behind, or NULL
+ *    @param  channel The multiplexer channel it is connected to
+ */
+void sim_attach(TwoWire *wire, uint8_t address, SimI2CTarget *target,
+                SimTCA9548A *mux, uint8_t channel) {
+  attachment_t a = {wire, address, target, mux, channel};
+  attached[attached_count++] = a;
+}
+
+/*!
+ *    @brief  Removes every simulated device
+ */
+void sim_detach_all(void) { attached_count = 0; }
+
+/*!
+ *    @brief  Finds the device answering at an address. Devices behind a
+ *            multiplexer are only reachable with their channel selected.
+ *    @param  wire The bus
+ *    @param  address The 7-bit address
+ *    @returns The device, or NULL if none or several would answer
+ */
+SimI2CTarget *sim_find(TwoWire *wire, uint8_t address) {
+  SimI2CTarget *found = NULL;
+  for (uint8_t i = 0; i < attached_count; i++) {
+    const attachment_t *a = &attached[i];
+    if (a->wire != wire || a->address != address)
+      continue;
+    if (a->mux && !(a->mux->selection & (1 << a->channel)))
+      continue;
+    if (found)
+      return NULL; // two devices answering garble the transfer
+    found = a->target;
+  }
+  return found;
+}
+
+/*!
+ *    @brief  Moves the clock on by the time a transfer takes: nine clocks
+ *            per byte including the address byte, plus start and stop
+ *    @param  wire The bus, for its clock
+ *    @param  bytes The bytes transferred, including the address byte
+ */
+void sim_transfer(TwoWire *wire, size_t bytes) {
+  unsigned long us = (bytes * 9 + 2) * 1000000UL / wire->clock;
+  now_us += us;
+  if (wire->realtime)
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
@@ -0,0 +1,45 @@
+/*!
+ *  @file test.h
+ *
+ *  Checks shared by the host tests. Each test is a program that prints the
+ *  failed checks and exits non-zero if there were any.
+ */
+
+#ifndef _TEST_TEST_H
+#define _TEST_TEST_H
+
+#include <math.h>
+#include <stdio.h>
+
+static int test_failures = 0;
+
+/*!
+ *    @brief  Records a failure if a condition is false
+ */
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);          \
+      test_failures++;                                                         \
+    }                                                                          \
+  } while (0)
+
+/*!
+ *    @brief  Records a failure if two values differ by more than a tolerance
+ */
+#define CHECK_NEAR(actual, expected, tolerance)                                \
+  do {                                                                         \
+    double a_ = (actual), e_ = (expected);                                     \
+    if (!(fabs(a_ - e_) <= (tolerance))) {                                     \
+      printf("%s:%d: %s is %g, expected %g +/- %g\n", __FILE__, __LINE__,      \
+             #actual, a_, e_, (double)(tolerance));                            \
+      test_failures++;                                                         \
+    }                                                                          \
+  } while (0)
+
+/*!
+ *    @brief  Exit status for the end of `main`
+ */
+#define TEST_RESULT() (test_failures ? 1 : 0)
+
+#endif
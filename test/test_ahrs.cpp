@@ -0,0 +1,135 @@
+/*!
+ *  @file test_ahrs.cpp
+ *
+ *  Compares the float and Q30 AHRS backends against synthetic motion with
+ *  a known orientation, and times both on the host
+ */
+
+#include <Adafruit_MPU6050_AHRS.h>
+
+#include <chrono>
+
+#include "test.h"
+
+#define RATE 1000       // samples per second
+#define GYRO_SCALE 131  // LSB per degree/s at 250 degree/s range
+#define ACCEL_1G 16384  // LSB per g at 2 g range
+#define BENCH_FRAMES 200000
+
+// frame for a sensor at the given roll and pitch, turning at the given rates
+static mpu6050_raw_frame_t frame_at(float roll, float pitch, float roll_rate,
+                                    float yaw_rate) {
+  float r = roll * DEG_TO_RAD, p = pitch * DEG_TO_RAD;
+  mpu6050_raw_frame_t frame = {};
+  frame.accel[0] = lround(-sin(p) * ACCEL_1G);
+  frame.accel[1] = lround(sin(r) * cos(p) * ACCEL_1G);
+  frame.accel[2] = lround(cos(r) * cos(p) * ACCEL_1G);
+  frame.gyro[0] = lround(roll_rate * GYRO_SCALE);
+  frame.gyro[2] = lround(yaw_rate * GYRO_SCALE);
+  return frame;
+}
+
+static void test_static_tilt(void) {
+  Adafruit_MPU6050_AHRS ahrs;
+  Adafruit_MPU6050_AHRS_Fixed fixed;
+  ahrs.begin(RATE, GYRO_SCALE, 2, 0);
+  fixed.begin(RATE, GYRO_SCALE, 2, 0);
+
+  mpu6050_raw_frame_t frame = frame_at(30, -20, 0, 0);
+  for (uint16_t n = 0; n < 5 * RATE; n++) {
+    ahrs.update(&frame);
+    fixed.update(&frame);
+  }
+
+  float roll, pitch, yaw;
+  ahrs.getEuler(&roll, &pitch, &yaw);
+  CHECK_NEAR(roll, 30, 0.05);
+  CHECK_NEAR(pitch, -20, 0.05);
+  fixed.getEuler(&roll, &pitch, &yaw);
+  CHECK_NEAR(roll, 30, 0.05);
+  CHECK_NEAR(pitch, -20, 0.05);
+}
+
+static void test_yaw_integration(void) {
+  Adafruit_MPU6050_AHRS ahrs;
+  Adafruit_MPU6050_AHRS_Fixed fixed;
+  ahrs.begin(RATE, GYRO_SCALE, 2, 0);
+  fixed.begin(RATE, GYRO_SCALE, 2, 0);
+
+  // gravity says nothing about yaw, so this is pure gyro integration
+  mpu6050_raw_frame_t frame = frame_at(0, 0, 0, 90);
+  for (uint16_t n = 0; n < RATE; n++) {
+    ahrs.update(&frame);
+    fixed.update(&frame);
+  }
+
+  float roll, pitch, yaw;
+  ahrs.getEuler(&roll, &pitch, &yaw);
+  CHECK_NEAR(yaw, 90, 0.05);
+  fixed.getEuler(&roll, &pitch, &yaw);
+  CHECK_NEAR(yaw, 90, 0.05);
+}
+
+static void test_tracks_swing(void) {
+  Adafruit_MPU6050_AHRS ahrs;
+  Adafruit_MPU6050_AHRS_Fixed fixed;
+  ahrs.begin(RATE, GYRO_SCALE, 2, 0);
+  fixed.begin(RATE, GYRO_SCALE, 2, 0);
+
+  // +/-20 degree roll at 0.5 Hz, fed in FIFO-sized blocks
+  const uint8_t block = 32;
+  mpu6050_raw_frame_t frames[block];
+  float worst = 0, worst_diff = 0;
+  for (uint16_t n = 0; n < 4 * RATE; n += block) {
+    for (uint8_t i = 0; i < block; i++) {
+      double t = (double)(n + i) / RATE;
+      float roll = 20 * sin(PI * t);
+      float rate = 20 * PI * cos(PI * t);
+      frames[i] = frame_at(roll, 0, rate, 0);
+    }
+    ahrs.update(frames, block);
+    fixed.update(frames, block);
+
+    double t = (double)(n + block - 1) / RATE;
+    float truth = 20 * sin(PI * t);
+    float roll, fixed_roll, pitch, yaw;
+    ahrs.getEuler(&roll, &pitch, &yaw);
+    fixed.getEuler(&fixed_roll, &pitch, &yaw);
+    if (fabs(roll - truth) > worst)
+      worst = fabs(roll - truth);
+    if (fabs(fixed_roll - roll) > worst_diff)
+      worst_diff = fabs(fixed_roll - roll);
+  }
+  CHECK_NEAR(worst, 0, 0.1);
+  CHECK_NEAR(worst_diff, 0, 0.01);
+  printf("swing: worst roll error %.4f deg, fixed vs float %.4f deg\n", worst,
+         worst_diff);
+}
+
+template <class Filter> static double bench(Filter *filter) {
+  static mpu6050_raw_frame_t frames[RATE];
+  for (uint16_t i = 0; i < RATE; i++)
+    frames[i] = frame_at(20 * sin(PI * i / RATE), 0,
+                         20 * PI * cos(PI * i / RATE), 0);
+
+  filter->begin(RATE, GYRO_SCALE, 2, 0.1);
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (uint32_t n = 0; n < BENCH_FRAMES; n += RATE)
+    filter->update(frames, RATE);
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / BENCH_FRAMES;
+}
+
+int main(void) {
+  test_static_tilt();
+  test_yaw_integration();
+  test_tracks_swing();
+
+  Adafruit_MPU6050_AHRS ahrs;
+  Adafruit_MPU6050_AHRS_Fixed fixed;
+  printf("float: %.1f ns/frame\n", bench(&ahrs));
+  printf("fixed: %.1f ns/frame\n", bench(&fixed));
+  return TEST_RESULT();
+}
@@ -0,0 +1,195 @@
+/*!
+ *  @file test_biquad.cpp
+ *
+ *  Runs the float and Q28 biquad banks against a double precision
+ *  reference on steps and sines, and times both on the host
+ */
+
+#include <Adafruit_MPU6050_Biquad.h>
+
+#include <chrono>
+
+#include "test.h"
+
+#define RATE 1000 // samples per second
+#define FRAMES 4000
+#define BLOCK 32 // frames per process call, so state carries across calls
+#define BENCH_FRAMES 200000
+
+static mpu6050_raw_frame_t frames[FRAMES];
+
+/*!
+ *    @brief  The same cascade in double precision, with no rounding
+ */
+class Reference {
+public:
+  void add(const mpu6050_biquad_t *c) {
+    _coeffs[_sections] = *c;
+    _sections++;
+  }
+
+  double process(double x) {
+    for (uint8_t s = 0; s < _sections; s++) {
+      const mpu6050_biquad_t *c = &_coeffs[s];
+      double *z = _state[s];
+      double y = c->b0 * x + c->b1 * z[0] + c->b2 * z[1] - c->a1 * z[2] -
+                 c->a2 * z[3];
+      z[1] = z[0];
+      z[0] = x;
+      z[3] = z[2];
+      z[2] = y;
+      x = y;
+    }
+    return x;
+  }
+
+private:
+  mpu6050_biquad_t _coeffs[MPU6050_BIQUAD_SECTIONS];
+  double _state[MPU6050_BIQUAD_SECTIONS][4] = {};
+  uint8_t _sections = 0;
+};
+
+// the same sections on the accel Z and gyro X axes of all three filters
+static void add_sections(Adafruit_MPU6050_Biquad *biquad,
+                         Adafruit_MPU6050_Biquad_Fixed *fixed,
+                         Reference *reference, mpu6050_biquad_type_t type,
+                         float frequency, float q, uint8_t count) {
+  mpu6050_biquad_t coeffs;
+  Adafruit_MPU6050_Biquad::design(&coeffs, type, frequency, RATE, q);
+  for (uint8_t s = 0; s < count; s++) {
+    for (uint8_t g = MPU6050_FILTER_ACCEL; g <= MPU6050_FILTER_GYRO; g++) {
+      CHECK(biquad->addSection((mpu6050_filter_group_t)g, &coeffs));
+      CHECK(fixed->addSection((mpu6050_filter_group_t)g, &coeffs));
+    }
+    reference->add(&coeffs);
+  }
+}
+
+// filters `frames`, whose accel Z is the input and gyro X its negative,
+// and returns the largest difference of each filter from the reference
+static void compare(Adafruit_MPU6050_Biquad *biquad,
+                    Adafruit_MPU6050_Biquad_Fixed *fixed,
+                    Reference *reference, double *worst_float,
+                    double *worst_fixed) {
+  static mpu6050_raw_frame_t out_float[FRAMES], out_fixed[FRAMES];
+  memcpy(out_float, frames, sizeof(frames));
+  memcpy(out_fixed, frames, sizeof(frames));
+  for (uint16_t i = 0; i < FRAMES; i += BLOCK) {
+    biquad->process(out_float + i, BLOCK);
+    fixed->process(out_fixed + i, BLOCK);
+  }
+
+  *worst_float = *worst_fixed = 0;
+  for (uint16_t i = 0; i < FRAMES; i++) {
+    double expected = reference->process(frames[i].accel[2]);
+    double e = fabs(out_float[i].accel[2] - expected);
+    if (e > *worst_float)
+      *worst_float = e;
+    e = fabs(out_fixed[i].accel[2] - expected);
+    if (e > *worst_fixed)
+      *worst_fixed = e;
+    // the gyro cascade sees the negated input
+    CHECK(out_fixed[i].gyro[0] + out_fixed[i].accel[2] >= -1);
+    CHECK(out_fixed[i].gyro[0] + out_fixed[i].accel[2] <= 1);
+  }
+}
+
+static void set_input(uint16_t i, int16_t value) {
+  frames[i] = mpu6050_raw_frame_t();
+  frames[i].accel[2] = value;
+  frames[i].gyro[0] = -value;
+}
+
+static void test_step(void) {
+  Adafruit_MPU6050_Biquad biquad;
+  Adafruit_MPU6050_Biquad_Fixed fixed;
+  Reference reference;
+  // fourth order low pass, from two Butterworth sections
+  add_sections(&biquad, &fixed, &reference, MPU6050_BIQUAD_LOWPASS, 5, 0.7071,
+               2);
+  for (uint16_t i = 0; i < FRAMES; i++)
+    set_input(i, i < 100 ? 0 : 12000);
+
+  double worst_float, worst_fixed;
+  compare(&biquad, &fixed, &reference, &worst_float, &worst_fixed);
+  CHECK_NEAR(worst_float, 0, 1.5);
+  CHECK_NEAR(worst_fixed, 0, 1.5);
+  printf("step: worst error float %.2f LSB, fixed %.2f LSB\n", worst_float,
+         worst_fixed);
+}
+
+static void test_small_step_low_corner(void) {
+  // A corner this low puts the poles within 0.005 of 1, where each
+  // section's input gain is 2.5e-6. Only the fractions fed back with the
+  // outputs let a step of a few LSBs through at all.
+  Adafruit_MPU6050_Biquad_Fixed fixed;
+  fixed.addSection(MPU6050_FILTER_ACCEL, MPU6050_BIQUAD_LOWPASS, 0.5, RATE);
+  for (uint16_t i = 0; i < FRAMES; i++)
+    set_input(i, 3);
+  for (uint16_t i = 0; i < FRAMES; i += BLOCK)
+    fixed.process(frames + i, BLOCK);
+
+  double mean = 0;
+  for (uint16_t i = FRAMES - 1000; i < FRAMES; i++)
+    mean += frames[i].accel[2] / 1000.0;
+  CHECK_NEAR(mean, 3, 0.05);
+  CHECK_NEAR(frames[FRAMES - 1].accel[2], 3, 1);
+}
+
+static void test_sine(void) {
+  Adafruit_MPU6050_Biquad biquad;
+  Adafruit_MPU6050_Biquad_Fixed fixed;
+  Reference reference;
+  // keeps 50 Hz and removes the slow swing under it
+  add_sections(&biquad, &fixed, &reference, MPU6050_BIQUAD_BANDPASS, 50, 2,
+               1);
+  add_sections(&biquad, &fixed, &reference, MPU6050_BIQUAD_HIGHPASS, 10,
+               0.7071, 1);
+  for (uint16_t i = 0; i < FRAMES; i++)
+    set_input(i, lround(10000 * sin(2 * PI * 50 * i / RATE) +
+                        8000 * sin(2 * PI * 2 * i / RATE)));
+
+  double worst_float, worst_fixed;
+  compare(&biquad, &fixed, &reference, &worst_float, &worst_fixed);
+  CHECK_NEAR(worst_float, 0, 1.5);
+  CHECK_NEAR(worst_fixed, 0, 1.5);
+  printf("sine: worst error float %.2f LSB, fixed %.2f LSB\n", worst_float,
+         worst_fixed);
+}
+
+template <class Filter> static double bench(Filter *filter) {
+  // two sections on each sensor, as in a typical low pass and notch
+  filter->addSection(MPU6050_FILTER_ACCEL, MPU6050_BIQUAD_LOWPASS, 20, RATE);
+  filter->addSection(MPU6050_FILTER_ACCEL, MPU6050_BIQUAD_NOTCH, 50, RATE);
+  filter->addSection(MPU6050_FILTER_GYRO, MPU6050_BIQUAD_LOWPASS, 20, RATE);
+  filter->addSection(MPU6050_FILTER_GYRO, MPU6050_BIQUAD_NOTCH, 50, RATE);
+
+  static mpu6050_raw_frame_t input[32 * BLOCK], block[BLOCK];
+  for (uint16_t i = 0; i < 32 * BLOCK; i++) {
+    int16_t v = lround(10000 * sin(2 * PI * 50 * i / RATE));
+    for (uint8_t a = 0; a < 3; a++)
+      input[i].accel[a] = input[i].gyro[a] = v;
+  }
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (uint32_t n = 0; n < BENCH_FRAMES; n += BLOCK) {
+    memcpy(block, input + n % (32 * BLOCK), sizeof(block));
+    filter->process(block, BLOCK);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return BENCH_FRAMES / elapsed.count();
+}
+
+int main(void) {
+  test_step();
+  test_small_step_low_corner();
+  test_sine();
+
+  Adafruit_MPU6050_Biquad biquad;
+  Adafruit_MPU6050_Biquad_Fixed fixed;
+  printf("float: %.0f samples/s\n", bench(&biquad));
+  printf("fixed: %.0f samples/s\n", bench(&fixed));
+  return TEST_RESULT();
+}
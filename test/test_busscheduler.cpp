@@ -0,0 +1,130 @@
+/*!
+ *  @file test_busscheduler.cpp
+ *
+ *  Polls simulated MPU6050s on three simulated buses, through the
+ *  sequential backend and through a backend with a thread per bus
+ */
+
+#include <Adafruit_MPU6050_BusScheduler.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "sim_mpu6050.h"
+#include "test.h"
+
+#define BUSES 3
+#define DEVICES 5
+#define POLLS 20
+
+/*!
+ *    @brief  Backend that runs each job on its own thread, recording how
+ *            many ran at once
+ */
+class ThreadBackend : public Adafruit_MPU6050_BusBackend {
+public:
+  void start(uint8_t bus, void (*job)(void *), void *arg) override {
+    (void)bus;
+    _threads.push_back(std::thread(run, this, job, arg));
+  }
+  void wait(void) override {
+    for (size_t i = 0; i < _threads.size(); i++)
+      _threads[i].join();
+    _threads.clear();
+  }
+
+  std::atomic<int> running{0}; ///< Jobs running now
+  std::atomic<int> most{0};    ///< Most jobs seen running at once
+
+private:
+  static void run(ThreadBackend *self, void (*job)(void *), void *arg) {
+    int now = ++self->running;
+    int most = self->most;
+    while (now > most && !self->most.compare_exchange_weak(most, now))
+      ;
+    job(arg);
+    self->running--;
+  }
+
+  std::vector<std::thread> _threads;
+};
+
+static TwoWire wires[BUSES];
+// bus of each device, added interleaved so bus and device order differ
+static const uint8_t BUS_OF[DEVICES] = {0, 1, 2, 0, 2};
+static const uint8_t ADDRESS_OF[DEVICES] = {0x68, 0x68, 0x68, 0x69, 0x69};
+
+static SimMPU6050 sims[DEVICES];
+static Adafruit_MPU6050 mpus[DEVICES];
+
+static void setup(Adafruit_MPU6050_BusScheduler *scheduler) {
+  sim_detach_all();
+  for (uint8_t i = 0; i < DEVICES; i++) {
+    sims[i].accel[0] = i * 0.25; // tells the devices' samples apart
+    sim_attach(&wires[BUS_OF[i]], ADDRESS_OF[i], &sims[i]);
+    CHECK(mpus[i].begin(ADDRESS_OF[i], &wires[BUS_OF[i]]));
+    CHECK(scheduler->addDevice(&mpus[i], &wires[BUS_OF[i]]) == i);
+  }
+  CHECK(scheduler->busCount() == BUSES);
+}
+
+// polls with transfers taking real time, returning the seconds taken
+static double run(Adafruit_MPU6050_BusScheduler *scheduler) {
+  mpu6050_sample_t samples[DEVICES];
+  uint16_t sequence[DEVICES];
+  uint32_t reads[DEVICES];
+  for (uint8_t i = 0; i < DEVICES; i++)
+    reads[i] = sims[i].data_reads;
+
+  for (uint8_t b = 0; b < BUSES; b++)
+    wires[b].realtime = true;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  for (uint8_t n = 0; n < POLLS; n++) {
+    CHECK(scheduler->poll(samples) == DEVICES);
+    for (uint8_t i = 0; i < DEVICES; i++) {
+      CHECK_NEAR(samples[i].raw.accel[0], i * 0.25 * 16384, 1);
+      if (n > 0)
+        CHECK(samples[i].sequence == (uint16_t)(sequence[i] + 1));
+      sequence[i] = samples[i].sequence;
+    }
+    // the devices of a bus are read in the order they were added
+    CHECK(sims[0].last_read < sims[3].last_read);
+    CHECK(sims[2].last_read < sims[4].last_read);
+  }
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  for (uint8_t b = 0; b < BUSES; b++)
+    wires[b].realtime = false;
+
+  for (uint8_t i = 0; i < DEVICES; i++)
+    CHECK(sims[i].data_reads - reads[i] == POLLS);
+  return elapsed.count();
+}
+
+int main(void) {
+  Adafruit_MPU6050_BusScheduler scheduler;
+  setup(&scheduler);
+
+  Adafruit_MPU6050_SequentialBackend sequential;
+  scheduler.setBackend(&sequential);
+  double sequential_time = run(&scheduler);
+
+  ThreadBackend threads;
+  scheduler.setBackend(&threads);
+  double threaded_time = run(&scheduler);
+  CHECK(threads.most == BUSES);
+
+  printf("%d devices on %d buses at 100 kHz: sequential %.0f samples/s, "
+         "threaded %.0f samples/s\n",
+         DEVICES, BUSES, POLLS * DEVICES / sequential_time,
+         POLLS * DEVICES / threaded_time);
+  // the busiest bus has two of the five devices
+  CHECK(threaded_time < 0.75 * sequential_time);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,128 @@
+/*!
+ *  @file test_calibration.cpp
+ *
+ *  Solves the six-position accelerometer calibration for a simulated
+ *  sensor with a known bias and scale/misalignment matrix, and checks the
+ *  driver's corrected readings
+ */
+
+#include <Adafruit_MPU6050_Calibration.h>
+
+#include "sim_mpu6050.h"
+#include "test.h"
+
+// reading = A * true + bias, in g
+static const float A[3][3] = {
+    {1.02, 0.01, -0.02}, {0.015, 0.97, 0.005}, {-0.01, 0.02, 1.05}};
+static const float BIAS[3] = {0.03, -0.02, 0.05};
+
+static void sense(const float truth[3], float reading[3]) {
+  for (uint8_t i = 0; i < 3; i++) {
+    reading[i] = BIAS[i];
+    for (uint8_t j = 0; j < 3; j++)
+      reading[i] += A[i][j] * truth[j];
+  }
+}
+
+static void add_positions(Adafruit_MPU6050_AccelCalibrator *calibrator) {
+  for (uint8_t o = MPU6050_X_UP; o <= MPU6050_Z_DOWN; o++) {
+    float truth[3] = {0, 0, 0};
+    truth[o / 2] = o % 2 ? -1 : 1;
+    float reading[3];
+    sense(truth, reading);
+    calibrator->addReading((mpu6050_orientation_t)o, reading);
+  }
+}
+
+static void test_solves_known_error(void) {
+  Adafruit_MPU6050_AccelCalibrator calibrator;
+  add_positions(&calibrator);
+  CHECK(calibrator.isComplete());
+
+  mpu6050_accel_cal_t cal;
+  CHECK(calibrator.solve(&cal));
+  for (uint8_t i = 0; i < 3; i++)
+    CHECK_NEAR(cal.bias[i], BIAS[i], 1e-5);
+}
+
+static void test_corrects_sensor(void) {
+  SimMPU6050 sim;
+  Adafruit_MPU6050 mpu;
+  sim_detach_all();
+  sim_attach(&Wire, MPU6050_I2CADDR_DEFAULT, &sim);
+  CHECK(mpu.begin());
+
+  // capture each position from the sensor itself
+  Adafruit_MPU6050_AccelCalibrator calibrator(&mpu);
+  for (uint8_t o = MPU6050_X_UP; o <= MPU6050_Z_DOWN; o++) {
+    float truth[3] = {0, 0, 0};
+    truth[o / 2] = o % 2 ? -1 : 1;
+    sense(truth, sim.accel);
+    CHECK(calibrator.capture((mpu6050_orientation_t)o, 50));
+  }
+  mpu6050_accel_cal_t cal;
+  CHECK(calibrator.solve(&cal));
+  mpu.setAccelerometerCalibration(&cal);
+
+  // any orientation, not just the six used, comes out as 1 g
+  const float tilted[][3] = {{0, 0, 1},
+                             {0, -1, 0},
+                             {0.6, 0, 0.8},
+                             {0.5, -0.5, 0.70710678f}};
+  for (uint8_t t = 0; t < sizeof(tilted) / sizeof(tilted[0]); t++) {
+    sense(tilted[t], sim.accel);
+    sensors_event_t accel, gyro, temp;
+    CHECK(mpu.getEvent(&accel, &gyro, &temp));
+    for (uint8_t i = 0; i < 3; i++)
+      CHECK_NEAR(accel.acceleration.v[i] / SENSORS_GRAVITY_STANDARD,
+                 tilted[t][i], 3e-4);
+  }
+
+  // and without the calibration the error is back
+  mpu.setAccelerometerCalibration(NULL);
+  sensors_event_t accel, gyro, temp;
+  CHECK(mpu.getEvent(&accel, &gyro, &temp));
+  CHECK(fabs(accel.acceleration.z / SENSORS_GRAVITY_STANDARD -
+             tilted[3][2]) > 0.01);
+}
+
+static void test_needs_all_positions(void) {
+  Adafruit_MPU6050_AccelCalibrator calibrator;
+  const float flat[3] = {0, 0, 1};
+  calibrator.addReading(MPU6050_Z_UP, flat);
+  CHECK(!calibrator.isComplete());
+
+  mpu6050_accel_cal_t cal;
+  CHECK(!calibrator.solve(&cal));
+}
+
+static void test_rejects_repeated_orientation(void) {
+  Adafruit_MPU6050_AccelCalibrator calibrator;
+  add_positions(&calibrator);
+
+  // the Y readings were taken with Z up by mistake
+  float reading[3];
+  const float z_up[3] = {0, 0, 1}, z_down[3] = {0, 0, -1};
+  sense(z_up, reading);
+  calibrator.addReading(MPU6050_Y_UP, reading);
+  sense(z_down, reading);
+  calibrator.addReading(MPU6050_Y_DOWN, reading);
+
+  mpu6050_accel_cal_t cal;
+  CHECK(!calibrator.solve(&cal));
+}
+
+static void test_capture_without_device(void) {
+  Adafruit_MPU6050_AccelCalibrator calibrator;
+  CHECK(!calibrator.capture(MPU6050_Z_UP));
+  CHECK(!calibrator.isComplete());
+}
+
+int main(void) {
+  test_solves_known_error();
+  test_corrects_sensor();
+  test_needs_all_positions();
+  test_rejects_repeated_orientation();
+  test_capture_without_device();
+  return TEST_RESULT();
+}
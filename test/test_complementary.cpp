@@ -0,0 +1,155 @@
+/*!
+ *  @file test_complementary.cpp
+ *
+ *  Runs the complementary filter against synthetic motion with a known
+ *  roll and pitch, and times it on the host
+ */
+
+#include <Adafruit_MPU6050_Complementary.h>
+
+#include <chrono>
+
+#include "test.h"
+
+#define RATE 1000      // samples per second
+#define GYRO_SCALE 131 // LSB per degree/s at 250 degree/s range
+#define ACCEL_1G 8192  // LSB per g at 4 g range, room for vibration
+#define BENCH_FRAMES 200000
+
+// frame for a sensor at the given roll and pitch, turning at the given rates
+static mpu6050_raw_frame_t frame_at(float roll, float pitch, float roll_rate,
+                                    float pitch_rate) {
+  float r = roll * DEG_TO_RAD, p = pitch * DEG_TO_RAD;
+  mpu6050_raw_frame_t frame = {};
+  frame.accel[0] = lround(-sin(p) * ACCEL_1G);
+  frame.accel[1] = lround(sin(r) * cos(p) * ACCEL_1G);
+  frame.accel[2] = lround(cos(r) * cos(p) * ACCEL_1G);
+  frame.gyro[0] = lround(roll_rate * GYRO_SCALE);
+  frame.gyro[1] = lround(pitch_rate * GYRO_SCALE);
+  return frame;
+}
+
+static void test_static_tilt(void) {
+  Adafruit_MPU6050_Complementary filter;
+  filter.begin(RATE, GYRO_SCALE);
+
+  // starts from the accelerometer's angles, and stays there
+  mpu6050_raw_frame_t frame = frame_at(30, -20, 0, 0);
+  filter.update(&frame);
+  CHECK_NEAR(filter.getRoll(), 30, 0.1);
+  CHECK_NEAR(filter.getPitch(), -20, 0.1);
+  for (uint16_t n = 0; n < 2 * RATE; n++)
+    filter.update(&frame);
+  CHECK_NEAR(filter.getRoll(), 30, 0.1);
+  CHECK_NEAR(filter.getPitch(), -20, 0.1);
+}
+
+static void test_gyro_integration(void) {
+  // with a crossover this low the accelerometer barely counts, so the
+  // angles are the integrated gyro
+  Adafruit_MPU6050_Complementary filter;
+  filter.begin(RATE, GYRO_SCALE, 0.001);
+
+  mpu6050_raw_frame_t level = frame_at(0, 0, 0, 0);
+  filter.update(&level);
+  mpu6050_raw_frame_t turning = frame_at(0, 0, 45, -30);
+  for (uint16_t n = 0; n < RATE; n++)
+    filter.update(&turning);
+  CHECK_NEAR(filter.getRoll(), 45, 0.3);
+  CHECK_NEAR(filter.getPitch(), -30, 0.3);
+}
+
+static void test_converges_to_accel(void) {
+  // a wrong start is pulled to the accelerometer's angles over a few
+  // time constants, 1 / (2 pi 0.5 Hz) each
+  Adafruit_MPU6050_Complementary filter;
+  filter.begin(RATE, GYRO_SCALE);
+  mpu6050_raw_frame_t frame = frame_at(0, 0, 0, 0);
+  filter.update(&frame);
+
+  frame = frame_at(40, 25, 0, 0);
+  for (uint16_t n = 0; n < 2 * RATE; n++)
+    filter.update(&frame);
+  CHECK_NEAR(filter.getRoll(), 40, 40 * 0.01);
+  CHECK_NEAR(filter.getPitch(), 25, 25 * 0.01);
+}
+
+static void test_rolls_over(void) {
+  // a steady roll through +/- 180, with matching gyro and accelerometer
+  Adafruit_MPU6050_Complementary filter;
+  filter.begin(RATE, GYRO_SCALE);
+
+  float worst = 0;
+  for (uint32_t n = 0; n < 4 * RATE; n++) {
+    float truth = fmod(90.0 * n / RATE + 180, 360) - 180;
+    mpu6050_raw_frame_t frame = frame_at(truth, 10, 90, 0);
+    filter.update(&frame);
+    float error = fabs(fmod(filter.getRoll() - truth + 540, 360) - 180);
+    if (error > worst)
+      worst = error;
+    CHECK(filter.getRoll() >= -180 && filter.getRoll() <= 180);
+  }
+  CHECK_NEAR(worst, 0, 0.2);
+  CHECK_NEAR(filter.getPitch(), 10, 0.2);
+  printf("roll over: worst roll error %.4f deg\n", worst);
+}
+
+static void test_rejects_vibration(void) {
+  // 0.2 g of 50 Hz vibration on Y, far above the crossover, is smoothed
+  // out. What is left follows the accelerometer's mean roll over a cycle,
+  // which the vibration itself shifts from 20 degrees.
+  Adafruit_MPU6050_Complementary filter;
+  filter.begin(RATE, GYRO_SCALE);
+  mpu6050_raw_frame_t still = frame_at(20, 0, 0, 0);
+  filter.update(&still);
+
+  static const uint8_t CYCLE = RATE / 50;
+  int16_t shaken[CYCLE];
+  double mean = 0;
+  for (uint8_t n = 0; n < CYCLE; n++) {
+    shaken[n] =
+        still.accel[1] + lround(0.2 * ACCEL_1G * sin(2 * PI * n / CYCLE));
+    mean += atan2(shaken[n], still.accel[2]) * RAD_TO_DEG / CYCLE;
+  }
+
+  float worst = 0;
+  for (uint16_t n = 0; n < 3 * RATE; n++) {
+    mpu6050_raw_frame_t frame = still;
+    frame.accel[1] = shaken[n % CYCLE];
+    filter.update(&frame);
+    if (n >= 2 * RATE && fabs(filter.getRoll() - mean) > worst)
+      worst = fabs(filter.getRoll() - mean);
+  }
+  CHECK_NEAR(worst, 0, 0.2);
+  printf("vibration: worst roll error %.4f deg\n", worst);
+}
+
+static double bench(void) {
+  static mpu6050_raw_frame_t frames[RATE];
+  for (uint16_t i = 0; i < RATE; i++)
+    frames[i] = frame_at(20 * sin(PI * i / RATE), 0,
+                         20 * PI * cos(PI * i / RATE), 0);
+
+  Adafruit_MPU6050_Complementary filter;
+  filter.begin(RATE, GYRO_SCALE);
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (uint32_t n = 0; n < BENCH_FRAMES; n += RATE)
+    filter.update(frames, RATE);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  // keeps the result live
+  CHECK(fabs(filter.getRoll()) <= 180);
+  return BENCH_FRAMES / elapsed.count();
+}
+
+int main(void) {
+  test_static_tilt();
+  test_gyro_integration();
+  test_converges_to_accel();
+  test_rolls_over();
+  test_rejects_vibration();
+
+  printf("complementary: %.0f samples/s\n", bench());
+  return TEST_RESULT();
+}
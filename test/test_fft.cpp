@@ -0,0 +1,121 @@
+/*!
+ *  @file test_fft.cpp
+ *
+ *  Transforms sines of known frequency and amplitude, from a few LSBs to
+ *  the full int16_t range, and checks the peak bin and its amplitude
+ */
+
+#include <Adafruit_MPU6050_FFT.h>
+
+#include "test.h"
+
+#define RATE 1000      // samples per second
+#define ACCEL_1G 16384 // LSB per g at 2 g range
+#define SIZE 512
+
+static int16_t buffer[SIZE];
+static mpu6050_raw_frame_t frames[SIZE];
+
+// a sine on the Z axis over a 1 g offset, clipped to the int16_t range
+static void make_sine(float frequency, float amplitude) {
+  for (uint16_t n = 0; n < SIZE; n++) {
+    float g = 1 + amplitude * sin(2 * PI * frequency * n / RATE);
+    float lsb = g * ACCEL_1G;
+    if (lsb > INT16_MAX)
+      lsb = INT16_MAX;
+    if (lsb < INT16_MIN)
+      lsb = INT16_MIN;
+    frames[n] = mpu6050_raw_frame_t();
+    frames[n].accel[2] = lround(lsb);
+  }
+}
+
+static void spectrum(Adafruit_MPU6050_FFT *fft, mpu6050_fft_window_t window) {
+  CHECK(fft->begin(RATE, ACCEL_1G, 2, window));
+  CHECK(fft->addFrames(frames, SIZE));
+  CHECK(fft->compute());
+}
+
+// largest bin other than those within `skip` of the peak
+static float leakage(Adafruit_MPU6050_FFT *fft, uint16_t peak, uint16_t skip) {
+  float most = 0;
+  for (uint16_t k = 1; k < SIZE / 2; k++) {
+    if (k + skip >= peak && k <= peak + skip)
+      continue;
+    if (fft->getAmplitude(k) > most)
+      most = fft->getAmplitude(k);
+  }
+  return most;
+}
+
+static void test_finds_sine(void) {
+  Adafruit_MPU6050_FFT fft(buffer, SIZE);
+  // bin 64, exactly
+  float frequency = 64.0 * RATE / SIZE;
+  make_sine(frequency, 0.5);
+
+  for (uint8_t w = MPU6050_WINDOW_RECTANGULAR; w <= MPU6050_WINDOW_HAMMING;
+       w++) {
+    spectrum(&fft, (mpu6050_fft_window_t)w);
+    CHECK_NEAR(fft.getBinFrequency(64), frequency, 1e-3);
+    CHECK_NEAR(fft.getAmplitude(64), 0.5, 0.005);
+    CHECK(leakage(&fft, 64, 2) < 0.005);
+
+    float peak, amplitude;
+    CHECK(fft.getPeaks(&peak, &amplitude, 1) == 1);
+    CHECK_NEAR(peak, frequency, 0.05);
+    CHECK_NEAR(amplitude, 0.5, 0.005);
+  }
+}
+
+static void test_finds_sine_between_bins(void) {
+  Adafruit_MPU6050_FFT fft(buffer, SIZE);
+  float frequency = 100.3 * RATE / SIZE;
+  make_sine(frequency, 0.2);
+  spectrum(&fft, MPU6050_WINDOW_HANN);
+
+  float peak, amplitude;
+  CHECK(fft.getPeaks(&peak, &amplitude, 1) == 1);
+  CHECK_NEAR(peak, frequency, 0.1 * RATE / SIZE);
+  CHECK_NEAR(amplitude, 0.2, 0.01);
+}
+
+static void test_small_sine(void) {
+  // a few LSBs, scaled up well before the transform, negatives included
+  Adafruit_MPU6050_FFT fft(buffer, SIZE);
+  make_sine(32.0 * RATE / SIZE, 40.0 / ACCEL_1G);
+  spectrum(&fft, MPU6050_WINDOW_HANN);
+
+  CHECK_NEAR(fft.getAmplitude(32) * ACCEL_1G, 40, 1);
+  CHECK(leakage(&fft, 32, 2) * ACCEL_1G < 1);
+}
+
+static void test_full_scale_sine(void) {
+  // a sine at a quarter of the rate from -32768 to 32767, which is
+  // 32767.5 LSB about a mean of -0.25 LSB
+  Adafruit_MPU6050_FFT fft(buffer, SIZE);
+  static const int16_t quarter[4] = {0, INT16_MAX, 0, INT16_MIN};
+  for (uint16_t n = 0; n < SIZE; n++) {
+    frames[n] = mpu6050_raw_frame_t();
+    frames[n].accel[2] = quarter[n % 4];
+  }
+
+  for (uint8_t w = MPU6050_WINDOW_RECTANGULAR; w <= MPU6050_WINDOW_HAMMING;
+       w++) {
+    spectrum(&fft, (mpu6050_fft_window_t)w);
+    float peak;
+    CHECK(fft.getPeaks(&peak, NULL, 1) == 1);
+    CHECK_NEAR(peak, RATE / 4.0, 0.05);
+    float amplitude = fft.getAmplitude(SIZE / 4) * ACCEL_1G;
+    CHECK_NEAR(amplitude, 32767.5, 32767.5 * 0.01);
+    CHECK(leakage(&fft, SIZE / 4, 2) * ACCEL_1G < amplitude * 0.01);
+  }
+}
+
+int main(void) {
+  test_finds_sine();
+  test_finds_sine_between_bins();
+  test_small_sine();
+  test_full_scale_sine();
+  return TEST_RESULT();
+}
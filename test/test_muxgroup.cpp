@@ -0,0 +1,116 @@
+/*!
+ *  @file test_muxgroup.cpp
+ *
+ *  Reads simulated MPU6050s behind a simulated TCA9548A, checking read
+ *  order and channel switching, and reports the sample rate achieved
+ */
+
+#include <Adafruit_MPU6050_MuxGroup.h>
+
+#include "sim_mpu6050.h"
+#include "test.h"
+
+#define DEVICES 4
+
+// channel and address of each device, in the order they are added
+static const uint8_t CHANNELS[DEVICES] = {5, 0, 3, 0};
+static const uint8_t ADDRESSES[DEVICES] = {0x68, 0x68, 0x68, 0x69};
+
+static SimTCA9548A mux;
+static SimMPU6050 sims[DEVICES];
+static Adafruit_MPU6050 mpus[DEVICES];
+static Adafruit_MPU6050_MuxGroup group;
+
+static void setup(void) {
+  sim_detach_all();
+  sim_attach(&Wire, MPU6050_MUX_I2CADDR_DEFAULT, &mux);
+  for (uint8_t i = 0; i < DEVICES; i++) {
+    sims[i].accel[0] = i * 0.25; // tells the devices' samples apart
+    sim_attach(&Wire, ADDRESSES[i], &sims[i], &mux, CHANNELS[i]);
+  }
+
+  CHECK(group.begin());
+  for (uint8_t i = 0; i < DEVICES; i++)
+    CHECK(group.addDevice(&mpus[i], CHANNELS[i], ADDRESSES[i]) == i);
+}
+
+// checks each device was read once, in channel order from `first`
+static void check_pass(const mpu6050_sample_t *samples, uint8_t first) {
+  uint8_t order[DEVICES];
+  for (uint8_t i = 0; i < DEVICES; i++)
+    order[i] = i;
+  for (uint8_t i = 0; i < DEVICES; i++)
+    for (uint8_t j = i + 1; j < DEVICES; j++)
+      if (sims[order[j]].last_read < sims[order[i]].last_read) {
+        uint8_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+      }
+  for (uint8_t i = 1; i < DEVICES; i++) {
+    uint8_t prev = (CHANNELS[order[i - 1]] + 8 - first) % 8;
+    uint8_t next = (CHANNELS[order[i]] + 8 - first) % 8;
+    CHECK(prev <= next);
+  }
+  for (uint8_t i = 0; i < DEVICES; i++)
+    CHECK_NEAR(samples[i].raw.accel[0], i * 0.25 * 16384, 1);
+}
+
+static void test_reads_in_channel_order(void) {
+  mpu6050_sample_t samples[DEVICES];
+  CHECK(group.deselect());
+  uint32_t switches = group.channelSwitches();
+  uint32_t writes = mux.writes;
+
+  // from no channel, the pass starts at channel 0: 0, 3 then 5
+  CHECK(group.getSamples(samples) == DEVICES);
+  check_pass(samples, 0);
+  CHECK(group.channelSwitches() - switches == 3);
+
+  // channel 5 is still selected, so it is read first without a switch
+  CHECK(group.getSamples(samples) == DEVICES);
+  check_pass(samples, 5);
+  CHECK(group.channelSwitches() - switches == 5);
+  CHECK(mux.writes - writes == group.channelSwitches() - switches);
+}
+
+static void test_counts_only_real_switches(void) {
+  uint32_t switches = group.channelSwitches();
+  CHECK(group.selectChannel(0)); // the last pass ended on channel 3
+  CHECK(group.selectChannel(5));
+  CHECK(group.selectChannel(5));
+  CHECK(group.selectDevice(0)); // also channel 5
+  CHECK(group.channelSwitches() - switches == 2);
+  CHECK(mux.selection == 1 << 5);
+
+  CHECK(!group.selectChannel(MPU6050_MUX_CHANNELS));
+  CHECK(group.channelSwitches() - switches == 2);
+}
+
+static float samples_per_second(uint32_t clock) {
+  Wire.setClock(clock);
+  mpu6050_sample_t samples[DEVICES];
+  const uint16_t passes = 100;
+  unsigned long start = micros();
+  uint32_t read = 0;
+  for (uint16_t n = 0; n < passes; n++)
+    read += group.getSamples(samples);
+  CHECK(read == passes * DEVICES);
+  return read * 1e6 / (micros() - start);
+}
+
+static void test_throughput(void) {
+  float slow = samples_per_second(100000);
+  float fast = samples_per_second(400000);
+  printf("%d devices on 3 channels: %.0f samples/s at 100 kHz, "
+         "%.0f samples/s at 400 kHz\n",
+         DEVICES, slow, fast);
+  CHECK(fast > 3.5 * slow);
+}
+
+int main(void) {
+  setup();
+  test_reads_in_channel_order();
+  test_counts_only_real_switches();
+  test_throughput();
+  return TEST_RESULT();
+}
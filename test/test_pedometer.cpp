@@ -0,0 +1,148 @@
+/*!
+ *  @file test_pedometer.cpp
+ *
+ *  Counts steps in synthetic walking and running, and checks that bumps
+ *  at no steady pace are not counted
+ */
+
+#include <Adafruit_MPU6050_Pedometer.h>
+
+#include "test.h"
+
+#define RATE 20        // samples per second, as from cycle mode
+#define ACCEL_1G 16384 // LSB per g at 2 g range
+#define BATCH 40       // frames per update, as drained from the FIFO
+
+static uint32_t seed = 1;
+
+// small repeatable noise, +/- range
+static int16_t noise(int16_t range) {
+  seed = seed * 1103515245 + 12345;
+  return (int16_t)((seed >> 16) % (2 * range + 1)) - range;
+}
+
+// accelerometer at 1 g plus an optional swing, tilted so the step shows on
+// two axes
+static mpu6050_raw_frame_t frame_at(float g) {
+  mpu6050_raw_frame_t frame = {};
+  frame.accel[0] = (int16_t)(0.6 * g * ACCEL_1G) + noise(150);
+  frame.accel[2] = (int16_t)(0.8 * g * ACCEL_1G) + noise(150);
+  return frame;
+}
+
+// feeds frames in batches, as drained from the FIFO
+static void feed(Adafruit_MPU6050_Pedometer *pedometer,
+                 const mpu6050_raw_frame_t *frames, uint16_t count) {
+  for (uint16_t i = 0; i < count; i += BATCH)
+    pedometer->update(frames + i, count - i < BATCH ? count - i : BATCH);
+}
+
+// steps at `hz`, or standing still when 0, for `seconds`
+static void segment(Adafruit_MPU6050_Pedometer *pedometer, float seconds,
+                    float hz, float swing) {
+  static mpu6050_raw_frame_t frames[60 * RATE];
+  uint16_t count = seconds * RATE;
+  for (uint16_t i = 0; i < count; i++)
+    frames[i] = frame_at(1 + swing * sin(TWO_PI * hz * i / RATE));
+  feed(pedometer, frames, count);
+}
+
+// a sharp knock: one sample up, one down
+static uint16_t bump(mpu6050_raw_frame_t *frames, uint16_t gap) {
+  for (uint16_t i = 0; i < gap; i++)
+    frames[i] = frame_at(1);
+  frames[0] = frame_at(1.5);
+  frames[2] = frame_at(0.5);
+  return gap;
+}
+
+static void test_walk_and_run(void) {
+  Adafruit_MPU6050_Pedometer pedometer;
+  pedometer.begin(RATE, ACCEL_1G);
+
+  segment(&pedometer, 10, 0, 0);
+  CHECK(pedometer.getSteps() == 0);
+  CHECK(pedometer.getActivity() == MPU6050_ACTIVITY_STILL);
+
+  segment(&pedometer, 30, 1.8, 0.3);
+  CHECK_NEAR(pedometer.getSteps(), 54, 2);
+  CHECK(pedometer.getActivity() == MPU6050_ACTIVITY_WALK);
+  CHECK_NEAR(pedometer.getCadence(), 108, 5);
+
+  segment(&pedometer, 10, 0, 0);
+  CHECK(pedometer.getActivity() == MPU6050_ACTIVITY_STILL);
+
+  pedometer.resetSteps();
+  segment(&pedometer, 20, 2.8, 1.0);
+  CHECK_NEAR(pedometer.getSteps(), 56, 2);
+  CHECK(pedometer.getActivity() == MPU6050_ACTIVITY_RUN);
+}
+
+static void test_ignores_lone_bump(void) {
+  Adafruit_MPU6050_Pedometer pedometer;
+  pedometer.begin(RATE, ACCEL_1G);
+  segment(&pedometer, 5, 0, 0);
+
+  mpu6050_raw_frame_t frames[BATCH];
+  feed(&pedometer, frames, bump(frames, BATCH));
+  CHECK(pedometer.getSteps() == 0);
+}
+
+static void test_ignores_irregular_bumps(void) {
+  Adafruit_MPU6050_Pedometer pedometer;
+  pedometer.begin(RATE, ACCEL_1G);
+  segment(&pedometer, 5, 0, 0);
+
+  // knocks 0.25 to 2 s apart, inside the step rate limits but at no pace
+  static mpu6050_raw_frame_t frames[104 * 2 * RATE];
+  uint32_t count = 0;
+  for (uint8_t n = 0; n < 104; n++) {
+    uint16_t gap = RATE / 4 + (noise(1000) + 1000) % (RATE * 7 / 4);
+    count += bump(frames + count, gap);
+  }
+  feed(&pedometer, frames, count);
+  printf("irregular bumps: %u of 104 counted\n",
+         (unsigned)pedometer.getSteps());
+  CHECK(pedometer.getSteps() == 0);
+}
+
+static void test_counts_bounce_once(void) {
+  // a knock every 0.6 s that rebounds at once and then sags: the rebound
+  // is too soon to be a step, and the sag after it is part of the same one
+  Adafruit_MPU6050_Pedometer pedometer;
+  pedometer.begin(RATE, ACCEL_1G);
+  segment(&pedometer, 5, 0, 0);
+
+  static mpu6050_raw_frame_t frames[40 * 12];
+  for (uint16_t n = 0; n < 40; n++) {
+    mpu6050_raw_frame_t *knock = frames + n * 12;
+    bump(knock, 12);
+    knock[3] = frame_at(1.5);
+    knock[4] = frame_at(0.5);
+    for (uint8_t i = 5; i < 8; i++)
+      knock[i] = frame_at(0.8);
+  }
+  feed(&pedometer, frames, 40 * 12);
+  CHECK_NEAR(pedometer.getSteps(), 40, 1);
+  CHECK_NEAR(pedometer.getCadence(), 100, 5);
+}
+
+static void test_walk_survives_bump(void) {
+  Adafruit_MPU6050_Pedometer pedometer;
+  pedometer.begin(RATE, ACCEL_1G);
+  segment(&pedometer, 20, 1.8, 0.3);
+
+  mpu6050_raw_frame_t frames[3];
+  feed(&pedometer, frames, bump(frames, 3));
+  segment(&pedometer, 20, 1.8, 0.3);
+  CHECK_NEAR(pedometer.getSteps(), 72, 4);
+}
+
+int main(void) {
+  test_walk_and_run();
+  test_ignores_lone_bump();
+  test_ignores_irregular_bumps();
+  test_counts_bounce_once();
+  test_walk_survives_bump();
+  return TEST_RESULT();
+}
@@ -0,0 +1,145 @@
+/*!
+ *  @file test_statistics.cpp
+ *
+ *  Checks windowed statistics against a direct two-pass computation over
+ *  the same samples, across window boundaries that fall inside the blocks
+ *  passed to `update`
+ */
+
+#include <Adafruit_MPU6050_Statistics.h>
+
+#include "test.h"
+
+#define WINDOW 250
+#define WINDOWS 6
+#define BLOCK 37 // frames per update, so windows end inside a block
+
+static mpu6050_raw_frame_t frames[WINDOW * WINDOWS];
+
+// the value of axis `a` (accel X to Z, then gyro X to Z) in a frame
+static int16_t value(const mpu6050_raw_frame_t *frame, uint8_t a) {
+  return a < 3 ? frame->accel[a] : frame->gyro[a - 3];
+}
+
+static const mpu6050_axis_stats_t *stat(const mpu6050_stats_t *stats,
+                                        uint8_t a) {
+  return a < 3 ? &stats->accel[a] : &stats->gyro[a - 3];
+}
+
+// checks each axis against the mean and variance computed in two passes
+static void check_window(const mpu6050_stats_t *stats,
+                         const mpu6050_raw_frame_t *window, uint16_t n) {
+  CHECK(stats->samples == n);
+  for (uint8_t a = 0; a < 6; a++) {
+    double mean = 0;
+    int16_t min = INT16_MAX, max = INT16_MIN;
+    for (uint16_t i = 0; i < n; i++) {
+      int16_t x = value(&window[i], a);
+      mean += x;
+      if (x < min)
+        min = x;
+      if (x > max)
+        max = x;
+    }
+    mean /= n;
+    double variance = 0;
+    for (uint16_t i = 0; i < n; i++) {
+      double d = value(&window[i], a) - mean;
+      variance += d * d;
+    }
+    variance /= n;
+
+    const mpu6050_axis_stats_t *s = stat(stats, a);
+    CHECK_NEAR(s->mean, mean, 1e-6 * fabs(mean) + 1e-3);
+    CHECK_NEAR(s->std_dev, sqrt(variance), 1e-4 * sqrt(variance) + 1e-3);
+    CHECK_NEAR(s->rms, sqrt(variance + mean * mean),
+               1e-5 * sqrt(variance + mean * mean) + 1e-3);
+    CHECK(s->min == min);
+    CHECK(s->max == max);
+  }
+}
+
+static void make_frames(void) {
+  // a different mean and spread on each axis and in each window, with a
+  // mean far from zero on accel Z so cancellation would show
+  uint32_t seed = 12345;
+  for (uint16_t i = 0; i < WINDOW * WINDOWS; i++) {
+    uint16_t w = i / WINDOW;
+    for (uint8_t a = 0; a < 6; a++) {
+      seed = seed * 1103515245 + 12345;
+      int32_t noise = (int32_t)((seed >> 16) % 2001) - 1000;
+      int32_t x = (a == 2 ? 16000 : -2000 * a) + 300 * w +
+                  noise * (a + 1) / (w + 1);
+      int16_t *out = a < 3 ? &frames[i].accel[a] : &frames[i].gyro[a - 3];
+      *out = x;
+    }
+  }
+  // and one window swinging over the whole int16_t range
+  for (uint16_t i = 3 * WINDOW; i < 4 * WINDOW; i++)
+    frames[i].gyro[2] = i % 2 ? INT16_MIN : INT16_MAX;
+}
+
+static void test_windows(void) {
+  Adafruit_MPU6050_Statistics stats;
+  stats.begin(MPU6050_STATS_WINDOW, WINDOW);
+  CHECK(!stats.available());
+
+  uint16_t completed = 0;
+  mpu6050_stats_t snapshot;
+  for (uint16_t i = 0; i < WINDOW * WINDOWS; i += BLOCK) {
+    uint16_t count = WINDOW * WINDOWS - i < BLOCK ? WINDOW * WINDOWS - i
+                                                  : BLOCK;
+    stats.update(frames + i, count);
+    if (!stats.available())
+      continue;
+    stats.getSnapshot(&snapshot);
+    CHECK(!stats.available());
+    // only the window just completed, none of the samples after it
+    check_window(&snapshot, frames + completed * WINDOW, WINDOW);
+    completed++;
+  }
+  CHECK(completed == WINDOWS);
+}
+
+static void test_unbounded(void) {
+  Adafruit_MPU6050_Statistics stats;
+  stats.begin(MPU6050_STATS_WINDOW, 0);
+  mpu6050_stats_t snapshot;
+
+  for (uint16_t i = 0; i < WINDOW * WINDOWS; i += WINDOW) {
+    stats.update(frames + i, WINDOW);
+    CHECK(stats.available());
+    stats.getSnapshot(&snapshot);
+    check_window(&snapshot, frames, i + WINDOW);
+  }
+
+  // starts over from the next sample after a reset
+  stats.reset();
+  stats.update(frames + WINDOW, WINDOW);
+  stats.getSnapshot(&snapshot);
+  check_window(&snapshot, frames + WINDOW, WINDOW);
+}
+
+static void test_exponential(void) {
+  // settles on the mean and spread of a long steady signal
+  Adafruit_MPU6050_Statistics stats;
+  stats.begin(MPU6050_STATS_EXPONENTIAL, 64);
+  for (uint8_t pass = 0; pass < 20; pass++)
+    stats.update(frames, WINDOW);
+  CHECK(stats.available());
+
+  mpu6050_stats_t snapshot;
+  stats.getSnapshot(&snapshot);
+  // the first window's accel Z is uniform over 16000 +/- 3000; over 64
+  // samples the estimates still wander by about 150
+  CHECK_NEAR(snapshot.accel[2].mean, 16000, 600);
+  CHECK_NEAR(snapshot.accel[2].std_dev, 3000 / sqrt(3), 500);
+}
+
+int main(void) {
+  make_frames();
+  test_windows();
+  test_unbounded();
+  test_exponential();
+  return TEST_RESULT();
+}
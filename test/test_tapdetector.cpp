@@ -0,0 +1,127 @@
+/*!
+ *  @file test_tapdetector.cpp
+ *
+ *  Feeds synthetic taps, double taps and vibration to the tap detector and
+ *  checks the events reported
+ */
+
+#include <Adafruit_MPU6050_TapDetector.h>
+
+#include "test.h"
+
+#define RATE 1000      // samples per second
+#define ACCEL_1G 16384 // LSB per g at 2 g range
+#define LENGTH 1500
+
+static int16_t x_axis[LENGTH];
+
+// a 3 ms spike of 1.5 g on X, which is a tap at the default timings
+static void add_tap(uint16_t at) {
+  for (uint16_t i = at; i < at + 3; i++)
+    x_axis[i] = 1.5 * ACCEL_1G;
+}
+
+// runs the signal through a detector one frame at a time, returning the
+// number of single and double taps and the sample the first was seen at
+static void detect(uint8_t *singles, uint8_t *doubles, uint16_t *first) {
+  Adafruit_MPU6050_TapDetector taps;
+  taps.begin(RATE, ACCEL_1G);
+  *singles = *doubles = 0;
+  *first = 0;
+
+  for (uint16_t i = 0; i < LENGTH; i++) {
+    mpu6050_raw_frame_t frame = {};
+    frame.accel[0] = x_axis[i];
+    frame.accel[2] = ACCEL_1G;
+    uint8_t events = taps.update(&frame, 1);
+    if (events && !*singles && !*doubles)
+      *first = i;
+    if (events & MPU6050_TAP_SINGLE)
+      (*singles)++;
+    if (events & MPU6050_TAP_DOUBLE)
+      (*doubles)++;
+    if (events) {
+      CHECK(taps.getTapAxis() == 0);
+      CHECK(taps.getTapDirection() == 1);
+    }
+  }
+}
+
+static void test_single_tap(void) {
+  memset(x_axis, 0, sizeof(x_axis));
+  add_tap(100);
+
+  uint8_t singles, doubles;
+  uint16_t first;
+  detect(&singles, &doubles, &first);
+  CHECK(singles == 1);
+  CHECK(doubles == 0);
+  // reported once the latency and the window have passed
+  CHECK_NEAR(first, 100 + 3 + 80 + 250, 2);
+}
+
+static void test_double_tap(void) {
+  memset(x_axis, 0, sizeof(x_axis));
+  add_tap(100);
+  add_tap(300);
+
+  uint8_t singles, doubles;
+  uint16_t first;
+  detect(&singles, &doubles, &first);
+  CHECK(singles == 0);
+  CHECK(doubles == 1);
+  // reported as the second tap ends
+  CHECK_NEAR(first, 303, 2);
+}
+
+static void test_late_second_tap(void) {
+  // the second tap comes after the window, so two single taps
+  memset(x_axis, 0, sizeof(x_axis));
+  add_tap(100);
+  add_tap(100 + 3 + 80 + 250 + 50);
+
+  uint8_t singles, doubles;
+  uint16_t first;
+  detect(&singles, &doubles, &first);
+  CHECK(singles == 2);
+  CHECK(doubles == 0);
+  CHECK_NEAR(first, 100 + 3 + 80 + 250, 2);
+}
+
+static void test_vibration_after_tap(void) {
+  // a tap, then vibration from inside the latency time on into the
+  // window. It is not a second tap, and the first is still reported.
+  memset(x_axis, 0, sizeof(x_axis));
+  add_tap(100);
+  for (uint16_t i = 150; i < 500; i++)
+    x_axis[i] = i % 8 < 4 ? 1.5 * ACCEL_1G : -1.5 * ACCEL_1G;
+
+  uint8_t singles, doubles;
+  uint16_t first;
+  detect(&singles, &doubles, &first);
+  CHECK(singles == 1);
+  CHECK(doubles == 0);
+  // as the vibration is seen in the window
+  CHECK_NEAR(first, 100 + 3 + 80, 2);
+}
+
+static void test_vibration_alone(void) {
+  memset(x_axis, 0, sizeof(x_axis));
+  for (uint16_t i = 150; i < 500; i++)
+    x_axis[i] = i % 8 < 4 ? 1.5 * ACCEL_1G : -1.5 * ACCEL_1G;
+
+  uint8_t singles, doubles;
+  uint16_t first;
+  detect(&singles, &doubles, &first);
+  CHECK(singles == 0);
+  CHECK(doubles == 0);
+}
+
+int main(void) {
+  test_single_tap();
+  test_double_tap();
+  test_late_second_tap();
+  test_vibration_after_tap();
+  test_vibration_alone();
+  return TEST_RESULT();
+}
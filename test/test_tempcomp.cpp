@@ -0,0 +1,160 @@
+/*!
+ *  @file test_tempcomp.cpp
+ *
+ *  Fits temperature compensation tables to known biases, and checks that
+ *  the gyro calibration trims only what a table leaves
+ */
+
+#include <Adafruit_MPU6050_Calibration.h>
+
+#include "sim_mpu6050.h"
+#include "test.h"
+
+#define POINTS MPU6050_TEMP_COMP_POINTS
+#define SHIFT 12
+
+// piecewise linear biases at the table points, with sharp bends
+static const float GYRO_AT[POINTS] = {0, 200, 100, 300, 250, -50, 0, 150};
+static const float ACCEL_AT[POINTS] = {-80, 40, -60, 20, 90, 10, -30, 60};
+
+static float interpolate(const float *at, int32_t temperature) {
+  int32_t offset = temperature - MPU6050_TEMP_RAW_MINUS_20C;
+  int32_t p = offset >> SHIFT;
+  if (p >= POINTS - 1)
+    return at[POINTS - 1];
+  float frac = (float)(offset - (p << SHIFT)) / (1 << SHIFT);
+  return at[p] + (at[p + 1] - at[p]) * frac;
+}
+
+static void test_keeps_every_sample(void) {
+  Adafruit_MPU6050_TempCompFitter fitter;
+  mpu6050_raw_frame_t frame = {};
+  frame.temperature = MPU6050_TEMP_RAW_MINUS_20C + (2 << SHIFT);
+
+  // more samples at one point than an int16_t count could hold
+  for (int32_t n = 0; n < 80000; n++) {
+    frame.gyro[0] = n < 40000 ? 100 : 200;
+    fitter.addSample(&frame);
+  }
+
+  mpu6050_temp_comp_t table;
+  CHECK(fitter.fit(&table));
+  for (uint8_t p = 0; p < POINTS; p++)
+    CHECK_NEAR(table.gyro[p][0], 150, 0);
+}
+
+static void test_fits_interpolated_bias(void) {
+  Adafruit_MPU6050_TempCompFitter fitter;
+  mpu6050_temp_comp_t table;
+  CHECK(!fitter.fit(&table));
+
+  // a sweep over the whole table, as the driver interpolates it
+  mpu6050_raw_frame_t frame = {};
+  int32_t top = MPU6050_TEMP_RAW_MINUS_20C + ((POINTS - 1) << SHIFT);
+  for (int32_t t = MPU6050_TEMP_RAW_MINUS_20C; t <= top; t += 7) {
+    frame.temperature = t;
+    frame.gyro[1] = lroundf(interpolate(GYRO_AT, t));
+    frame.accel[2] = lroundf(interpolate(ACCEL_AT, t));
+    fitter.addSample(&frame);
+  }
+
+  int16_t reference = MPU6050_TEMP_RAW_MINUS_20C + (3 << SHIFT);
+  CHECK(fitter.fit(&table, reference));
+  for (uint8_t p = 0; p < POINTS; p++) {
+    CHECK_NEAR(table.gyro[p][1], GYRO_AT[p], 1);
+    CHECK_NEAR(table.accel[p][2], ACCEL_AT[p] - ACCEL_AT[3], 1);
+    CHECK_NEAR(table.gyro[p][0], 0, 0);
+  }
+}
+
+static void test_fills_points_without_samples(void) {
+  Adafruit_MPU6050_TempCompFitter fitter;
+  mpu6050_raw_frame_t frame = {};
+
+  // samples only at points 2 and 5
+  for (uint8_t n = 0; n < 100; n++) {
+    frame.temperature = MPU6050_TEMP_RAW_MINUS_20C + (2 << SHIFT);
+    frame.gyro[2] = 30;
+    fitter.addSample(&frame);
+    frame.temperature = MPU6050_TEMP_RAW_MINUS_20C + (5 << SHIFT);
+    frame.gyro[2] = 90;
+    fitter.addSample(&frame);
+  }
+
+  mpu6050_temp_comp_t table;
+  CHECK(fitter.fit(&table));
+  static const int16_t expected[POINTS] = {30, 30, 30, 50, 70, 90, 90, 90};
+  for (uint8_t p = 0; p < POINTS; p++)
+    CHECK_NEAR(table.gyro[p][2], expected[p], 0);
+}
+
+// the sensor's gyro bias in deg/s: a fixed part plus a drift with
+// temperature
+static float fixed_bias[3] = {1.5, -2.0, 0.8};
+static const float DRIFT[3] = {0.04, -0.03, 0.02};
+
+static void set_temperature(SimMPU6050 *sim, float celsius) {
+  sim->temperature = celsius;
+  for (uint8_t i = 0; i < 3; i++)
+    sim->gyro[i] = fixed_bias[i] + DRIFT[i] * (celsius - 25);
+}
+
+static void mean_gyro(Adafruit_MPU6050 *mpu, float mean[3]) {
+  float scale = mpu->getGyroScale();
+  mpu6050_sample_t sample;
+  for (uint8_t i = 0; i < 3; i++)
+    mean[i] = 0;
+  for (uint8_t n = 0; n < 20; n++) {
+    CHECK(mpu->getSample(&sample));
+    for (uint8_t i = 0; i < 3; i++)
+      mean[i] += sample.raw.gyro[i] / scale / 20;
+  }
+}
+
+static void test_calibrates_with_table(void) {
+  SimMPU6050 sim;
+  Adafruit_MPU6050 mpu;
+  sim_detach_all();
+  sim_attach(&Wire, MPU6050_I2CADDR_DEFAULT, &sim);
+  CHECK(mpu.begin());
+  mpu.setGyroRange(MPU6050_RANGE_500_DEG);
+
+  Adafruit_MPU6050_TempCompFitter fitter;
+  mpu6050_sample_t sample;
+  for (float celsius = -10; celsius <= 60; celsius += 0.5) {
+    set_temperature(&sim, celsius);
+    for (uint8_t n = 0; n < 10; n++) {
+      CHECK(mpu.getSample(&sample));
+      fitter.addSample(&sample.raw);
+    }
+  }
+  mpu6050_temp_comp_t table;
+  CHECK(fitter.fit(&table));
+  mpu.setTemperatureCompensation(&table);
+
+  // the fixed part has moved since the sweep
+  fixed_bias[0] += 0.6;
+  fixed_bias[1] -= 0.4;
+  set_temperature(&sim, 40);
+  float residual = mpu.calibrateGyro(200);
+  CHECK(residual >= 0 && residual < 0.05);
+
+  float mean[3];
+  mean_gyro(&mpu, mean);
+  for (uint8_t i = 0; i < 3; i++)
+    CHECK_NEAR(mean[i], 0, 0.05);
+
+  // and the table still tracks the drift away from where it calibrated
+  set_temperature(&sim, 5);
+  mean_gyro(&mpu, mean);
+  for (uint8_t i = 0; i < 3; i++)
+    CHECK_NEAR(mean[i], 0, 0.05);
+}
+
+int main(void) {
+  test_keeps_every_sample();
+  test_fits_interpolated_bias();
+  test_fills_points_without_samples();
+  test_calibrates_with_table();
+  return TEST_RESULT();
+}